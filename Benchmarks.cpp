@@ -0,0 +1,270 @@
+#include "Benchmarks.h"
+#include <algorithm>
+#include <any>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include "compiler/AsyncIO.h"
+#include "compiler/Channel.h"
+#include "compiler/CompiledProgram.h"
+#include "compiler/NativeBinding.h"
+#include "compiler/PropertyDictionary.h"
+#include "compiler/Scheduler.h"
+using namespace std::chrono;
+
+int runThreadsBenchmark(const std::string &source, int threads, bool printStats) {
+    // Every thread asks for the program, it is compiled once and shared
+    ProgramCache cache;
+    std::vector<std::shared_ptr<const CompiledProgram>> programs(threads);
+    std::vector<std::exception_ptr> errors(threads);
+    std::vector<std::thread> workers;
+    auto start = high_resolution_clock::now();
+    for (int i = 0; i < threads; i++) {
+        workers.emplace_back([&cache, &programs, &errors, &source, i]() {
+            try {
+                programs[i] = cache.get(source);
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+        });
+    }
+    for (auto &worker: workers) {
+        worker.join();
+    }
+    for (const auto &error: errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+    auto duration = duration_cast<milliseconds>(high_resolution_clock::now() - start);
+    std::cout << "Program compiled " << cache.compiled() << " time(s) for " << threads << " threads in "
+              << duration.count() << "ms" << std::endl;
+    if (printStats) {
+        programs[0]->getCompiler().printStatistics(std::cout);
+    }
+    return 0;
+}
+
+int runJobsBenchmark(int jobs, int repeat, const std::vector<std::string> &files) {
+    // Compiles every file K times as independent tasks, long and short ones mixed together
+    std::vector<std::string> sources;
+    for (const auto &file: files) {
+        std::ifstream input(file);
+        if (!input) {
+            std::cout << "Failed to open file " << file << std::endl;
+            return 1;
+        }
+        sources.emplace_back((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+    }
+
+    Scheduler scheduler(jobs);
+    for (int i = 0; i < repeat; i++) {
+        for (const auto &source: sources) {
+            scheduler.submit([&source]() {
+                CompiledProgram::compile(source);
+            });
+        }
+    }
+    scheduler.printStatistics(std::cout);
+    return 0;
+}
+
+int runPipelineBenchmark(int megabytes) {
+    // Producer -> transformer -> consumer over 8 MB numeric arrays. Once moving the arrays through the
+    // channels, once copying them on every send like a deep-copying message port
+    const size_t length = 1 << 20;
+    const size_t arrayMegabytes = length * sizeof(double) / (1024 * 1024);
+    if (megabytes < static_cast<int>(arrayMegabytes)) {
+        std::cerr << "--pipeline needs at least " << arrayMegabytes << " MB, one array" << std::endl;
+        return 1;
+    }
+    size_t count = static_cast<size_t>(megabytes) / arrayMegabytes;
+    for (bool copy: {false, true}) {
+        Channel<std::vector<double>> produced(4);
+        Channel<std::vector<double>> transformed(4);
+        auto send = [copy](Channel<std::vector<double>> &channel, std::vector<double> &array) {
+            return copy ? channel.send(array) : channel.send(std::move(array));
+        };
+
+        auto start = high_resolution_clock::now();
+        std::thread producer([&]() {
+            for (size_t i = 0; i < count; i++) {
+                std::vector<double> array(length, static_cast<double>(i % 100));
+                send(produced, array);
+            }
+            produced.close();
+        });
+        std::thread transformer([&]() {
+            while (auto array = produced.receive()) {
+                for (auto &value: *array) {
+                    value = value * 0.5 + 1;
+                }
+                send(transformed, *array);
+            }
+            transformed.close();
+        });
+        double checksum = 0;
+        while (auto array = transformed.receive()) {
+            for (auto value: *array) {
+                checksum += value;
+            }
+        }
+        producer.join();
+        transformer.join();
+
+        auto duration = duration_cast<milliseconds>(high_resolution_clock::now() - start);
+        std::cout << "Pipeline (" << (copy ? "copied" : "moved") << "): " << count * arrayMegabytes
+                  << " MB in " << duration.count() << "ms, checksum " << checksum << std::endl;
+    }
+    return 0;
+}
+
+int runReadBenchmark(int reads, const std::vector<std::string> &files) {
+    // N reads of the given files: coroutines on one event loop thread, then one blocking read after another
+    EventLoop loop;
+    std::vector<Task<std::string>> readers;
+    for (int i = 0; i < reads; i++) {
+        readers.push_back(readFile(loop, files[i % files.size()]));
+    }
+    auto start = high_resolution_clock::now();
+    loop.run(readers);
+    size_t bytes = 0;
+    for (auto &reader: readers) {
+        bytes += reader.result().size();
+    }
+    auto duration = duration_cast<microseconds>(high_resolution_clock::now() - start);
+    std::cout << "Read " << reads << " files (" << bytes << " bytes) in " << duration.count() << "us "
+              << (loop.usesRing() ? "with io_uring" : "synchronously") << ", " << loop.peakInFlight()
+              << " reads in flight at most" << std::endl;
+
+    start = high_resolution_clock::now();
+    bytes = 0;
+    for (int i = 0; i < reads; i++) {
+        std::ifstream input(files[i % files.size()], std::ios::binary);
+        bytes += std::string((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>()).size();
+    }
+    duration = duration_cast<microseconds>(high_resolution_clock::now() - start);
+    std::cout << "Read " << reads << " files (" << bytes << " bytes) in " << duration.count() << "us blocking" << std::endl;
+    return 0;
+}
+
+static double scaleNative(double value, double factor, bool negate) {
+    return negate ? -value * factor : value * factor;
+}
+
+static int32_t lengthNative(std::string_view text) {
+    return static_cast<int32_t>(text.size());
+}
+
+// The usual generic binding: arguments are boxed into a vector of std::any and unboxed again in the wrapper
+using GenericFunction = std::function<std::any(const std::vector<std::any> &)>;
+
+template<typename R, typename... Args, size_t... I>
+static R callGeneric(R (*function)(Args...), const std::vector<std::any> &args, std::index_sequence<I...>) {
+    return function(std::any_cast<std::decay_t<Args>>(args[I])...);
+}
+
+template<typename R, typename... Args>
+static GenericFunction bindGeneric(R (*function)(Args...)) {
+    return [function](const std::vector<std::any> &args) -> std::any {
+        if (args.size() != sizeof...(Args)) {
+            throw std::runtime_error("Pogrešan broj argumenata");
+        }
+        return callGeneric(function, args, std::index_sequence_for<Args...>());
+    };
+}
+
+static std::any unbox(Value value) {
+    if (value.isNumber()) return value.asNumber();
+    if (value.isBoolean()) return value.asBoolean();
+    if (value.isString()) return std::string_view(*value.asString());
+    return {};
+}
+
+int runBindBenchmark(int calls) {
+    // The same native functions called N times through a generated thunk and through the generic binding
+    std::string text = "bosscript";
+    std::vector<Value> values(1024);
+    for (size_t i = 0; i < values.size(); i++) {
+        values[i] = Value::number(static_cast<double>(i) * 0.5);
+    }
+    Value negate[] = {Value::boolean(false), Value::boolean(true)};
+    Value textValue = Value::string(&text);
+
+    NativeFunction scaleThunk = bindNative<&scaleNative>();
+    NativeFunction lengthThunk = bindNative<&lengthNative>();
+    GenericFunction scaleGeneric = bindGeneric(&scaleNative);
+    GenericFunction lengthGeneric = bindGeneric(&lengthNative);
+
+    for (bool generic: {false, true}) {
+        double checksum = 0;
+        auto start = high_resolution_clock::now();
+        for (int i = 0; i < calls; i++) {
+            Value args[] = {values[i % values.size()], values[(i + 1) % values.size()], negate[i & 1]};
+            if (generic) {
+                std::vector<std::any> scaleArgs{unbox(args[0]), unbox(args[1]), unbox(args[2])};
+                std::vector<std::any> lengthArgs{unbox(textValue)};
+                checksum += std::any_cast<double>(scaleGeneric(scaleArgs));
+                checksum += std::any_cast<int32_t>(lengthGeneric(lengthArgs));
+            } else {
+                checksum += scaleThunk(args, 3).asNumber();
+                checksum += lengthThunk(&textValue, 1).asInteger();
+            }
+        }
+        auto duration = duration_cast<microseconds>(high_resolution_clock::now() - start);
+        std::cout << (generic ? "Generic binding" : "Native thunks") << ": " << 2 * static_cast<long long>(calls)
+                  << " calls in " << duration.count() << "us, checksum " << checksum << std::endl;
+    }
+    return 0;
+}
+
+int runDictionaryBenchmark(int keyCount) {
+    // N even keys inserted, looked up (half of the lookups miss) and erased, in PropertyDictionary and
+    // std::unordered_map. Keys are visited in a shuffled order, not the order they were interned in
+    std::vector<uint32_t> keys(static_cast<size_t>(keyCount) * 2);
+    for (size_t i = 0; i < keys.size(); i++) {
+        keys[i] = static_cast<uint32_t>(i);
+    }
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(42));
+    auto run = [&keys](const char *name, auto &&insert, auto &&find, auto &&erase) {
+        uint64_t checksum = 0;
+        auto start = high_resolution_clock::now();
+        for (uint32_t key: keys) {
+            if (key % 2 == 0) insert(key, key);
+        }
+        auto inserted = high_resolution_clock::now();
+        for (uint32_t key: keys) {
+            checksum += find(key).value_or(1);
+        }
+        auto found = high_resolution_clock::now();
+        for (uint32_t key: keys) {
+            if (key % 2 == 0) checksum += erase(key);
+        }
+        auto erased = high_resolution_clock::now();
+        std::cout << name << ": insert " << duration_cast<microseconds>(inserted - start).count()
+                  << "us, lookup " << duration_cast<microseconds>(found - inserted).count()
+                  << "us, erase " << duration_cast<microseconds>(erased - found).count()
+                  << "us, checksum " << checksum << std::endl;
+    };
+
+    PropertyDictionary dictionary;
+    run("PropertyDictionary",
+        [&](uint32_t key, uint32_t value) { dictionary.insert(key, value); },
+        [&](uint32_t key) { return dictionary.find(key); },
+        [&](uint32_t key) { return dictionary.erase(key); });
+
+    std::unordered_map<uint32_t, uint32_t> map;
+    run("std::unordered_map",
+        [&](uint32_t key, uint32_t value) { map.emplace(key, value); },
+        [&](uint32_t key) {
+            auto found = map.find(key);
+            return found == map.end() ? std::nullopt : std::optional<uint32_t>(found->second);
+        },
+        [&](uint32_t key) { return map.erase(key) == 1; });
+    return 0;
+}
@@ -0,0 +1,28 @@
+#ifndef BOSSCRIPT_BENCHMARKS_H
+#define BOSSCRIPT_BENCHMARKS_H
+
+#include <string>
+#include <vector>
+
+// Benchmarks behind the command line flags. Each prints its results and returns the process exit code
+
+// --threads N: N threads ask a ProgramCache for the same source
+int runThreadsBenchmark(const std::string &source, int threads, bool printStats);
+
+// --jobs N: every file compiled repeat times as independent tasks on N workers
+int runJobsBenchmark(int jobs, int repeat, const std::vector<std::string> &files);
+
+// --pipeline MB: 8 MB arrays through a three stage pipeline, moved and then copied
+int runPipelineBenchmark(int megabytes);
+
+// --read N: N file reads on the event loop, then blocking
+int runReadBenchmark(int reads, const std::vector<std::string> &files);
+
+// --bind N: native calls through generated thunks and through a generic binding
+int runBindBenchmark(int calls);
+
+// --dict N: PropertyDictionary against std::unordered_map
+int runDictionaryBenchmark(int keys);
+
+
+#endif //BOSSCRIPT_BENCHMARKS_H
@@ -0,0 +1,182 @@
+#include "ArenaAllocation.h"
+#include "Bindings.h"
+#include "../parser/AST/ASTWalker.h"
+
+void ArenaAllocation::run(Program &program) {
+    ASTWalker::walk(&program, [this](Statement *statement) {
+        if (statement->kind == NodeType::FunctionDeclaration) {
+            auto declaration = static_cast<FunctionDeclaration *>(statement);
+            analyzeFunction(declaration->body.get(), declaration->params);
+        }
+        else if (statement->kind == NodeType::FunctionExpression) {
+            auto expression = static_cast<FunctionExpression *>(statement);
+            analyzeFunction(expression->body.get(), expression->params);
+        }
+        return true;
+    });
+}
+
+void ArenaAllocation::printStatistics(std::ostream &os) const {
+    os << "Arena allocation: " << arenaSites << " of " << sites << " allocation sites in functions" << std::endl;
+}
+
+bool ArenaAllocation::constructorKeepsInstance(const ModelDefinitionStatement *model) {
+    auto cached = constructors.find(model);
+    if (cached != constructors.end()) {
+        return cached->second;
+    }
+
+    auto &result = constructors[model];
+    if (model->parentClassName) {
+        auto parent = models.modelOf(model->parentClassName->symbol);
+        if (!parent || !constructorKeepsInstance(parent)) {
+            return result;
+        }
+    }
+
+    // Methods can store @, so calling one counts as an escape. So does any use of @ in a nested function
+    bool escapes = false;
+    std::function<void(Statement *, bool)> scan = [&](Statement *node, bool nested) {
+        ASTWalker::walk(node, [&](Statement *statement) {
+            switch (statement->kind) {
+                case NodeType::FunctionDeclaration:
+                case NodeType::FunctionExpression:
+                case NodeType::ModelDefinition:
+                    if (statement != node) {
+                        scan(statement, true);
+                        return false;
+                    }
+                    return true;
+                case NodeType::Identifier:
+                    escapes = escapes || static_cast<Identifier *>(statement)->symbol == "@";
+                    return false;
+                case NodeType::CallExpression: {
+                    auto callee = dynamic_cast<MemberExpression *>(static_cast<CallExpression *>(statement)->callee.get());
+                    if (callee && callee->targetObject->kind == NodeType::Identifier
+                        && static_cast<Identifier *>(callee->targetObject.get())->symbol == "@") {
+                        escapes = true;
+                    }
+                    return true;
+                }
+                case NodeType::MemberExpression: {
+                    auto member = static_cast<MemberExpression *>(statement);
+                    if (nested || member->targetObject->kind != NodeType::Identifier
+                        || static_cast<Identifier *>(member->targetObject.get())->symbol != "@") {
+                        return true;
+                    }
+                    if (member->isComputed) {
+                        scan(member->property.get(), nested);
+                    }
+                    return false;
+                }
+                default:
+                    return true;
+            }
+        });
+    };
+
+    scan(model->constructor->body.get(), false);
+    for (auto block: {model->privateBlock.get(), model->publicBlock.get()}) {
+        if (!block) continue;
+        for (const auto &member: block->getBody()) {
+            if (member->kind == NodeType::VariableStatement) {
+                scan(member.get(), false);
+            }
+        }
+    }
+    result = !escapes;
+    return result;
+}
+
+bool ArenaAllocation::isAllocation(Expression *expression) const {
+    if (expression == nullptr) {
+        return false;
+    }
+    if (expression->kind == NodeType::Object || expression->kind == NodeType::ArrayLiteral) {
+        return true;
+    }
+    if (expression->kind != NodeType::CallExpression) {
+        return false;
+    }
+    auto callee = static_cast<CallExpression *>(expression)->callee.get();
+    if (callee->kind != NodeType::Identifier) {
+        return false;
+    }
+    return models.modelOf(static_cast<Identifier *>(callee)->symbol) != nullptr;
+}
+
+void ArenaAllocation::analyzeFunction(BlockStatement *body, const std::vector<std::unique_ptr<FunctionParameter>> &params) {
+    std::map<std::string, Expression *> candidates;
+    std::set<std::string> rejected;
+
+    auto isNestedFunction = [](Statement *statement) {
+        return statement->kind == NodeType::FunctionDeclaration || statement->kind == NodeType::FunctionExpression
+               || statement->kind == NodeType::ModelDefinition;
+    };
+
+    // The arena is only reset when the function returns, so an allocation in a loop would grow it on every iteration
+    std::set<Statement *> inLoop;
+    ASTWalker::walk(body, [&](Statement *statement) {
+        if (isNestedFunction(statement)) {
+            return false;
+        }
+        auto kind = statement->kind;
+        if (kind == NodeType::WhileStatement || kind == NodeType::DoWhileStatement || kind == NodeType::ForStatement
+            || kind == NodeType::ForEachStatement) {
+            ASTWalker::walk(statement, [&](Statement *inner) {
+                if (isNestedFunction(inner)) {
+                    return false;
+                }
+                inLoop.insert(inner);
+                return true;
+            });
+            return false;
+        }
+        return true;
+    });
+
+    ASTWalker::walk(body, [&](Statement *statement) {
+        if (isNestedFunction(statement)) {
+            return false;
+        }
+        if (auto expression = dynamic_cast<Expression *>(statement); isAllocation(expression)) {
+            sites++;
+        }
+        if (statement->kind == NodeType::VariableDeclaration) {
+            auto declaration = static_cast<VariableDeclaration *>(statement);
+            if (candidates.count(declaration->name)) {
+                rejected.insert(declaration->name);
+            }
+            auto value = declaration->value.get();
+            if (isAllocation(value) && !inLoop.count(value) && (value->kind != NodeType::CallExpression || constructorKeepsInstance(
+                    models.modelOf(static_cast<Identifier *>(static_cast<CallExpression *>(value)->callee.get())->symbol)))) {
+                candidates.emplace(declaration->name, value);
+            }
+        }
+        return true;
+    });
+    for (const auto &param: params) {
+        rejected.insert(param->identifier->symbol);
+    }
+
+    auto escaping = Bindings::escapingNames(body);
+    rejected.insert(escaping.begin(), escaping.end());
+
+    for (const auto &[name, allocation]: candidates) {
+        if (rejected.count(name)) {
+            continue;
+        }
+        switch (allocation->kind) {
+            case NodeType::Object:
+                static_cast<ObjectLiteral *>(allocation)->inArena = true;
+                break;
+            case NodeType::ArrayLiteral:
+                static_cast<ArrayLiteral *>(allocation)->inArena = true;
+                break;
+            default:
+                static_cast<CallExpression *>(allocation)->inArena = true;
+                break;
+        }
+        arenaSites++;
+    }
+}
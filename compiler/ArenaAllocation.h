@@ -0,0 +1,40 @@
+#ifndef BOSSCRIPT_ARENAALLOCATION_H
+#define BOSSCRIPT_ARENAALLOCATION_H
+
+#include "ModelAnalyzer.h"
+#include "Pass.h"
+
+// Finds object literals, array literals and model constructor calls inside functions whose result never
+// outlives the invocation, so they can be placed in a per-invocation arena that is reset when the function
+// returns. An allocation qualifies when it initializes a local variable that is only used to read or write
+// its properties and elements: passing, returning, storing, reassigning, calling a method on it or capturing
+// it in a nested function lets it escape. Allocations at the top level of the program are never in an arena,
+// and neither are allocations in a loop body, which would keep the arena growing until the function returns.
+// Model instances also need a constructor (and field initializers) that only use @ to read or write fields.
+class ArenaAllocation : public Pass {
+private:
+    const ModelAnalyzer &models;
+    std::map<const ModelDefinitionStatement *, bool> constructors;
+    size_t sites = 0;
+    size_t arenaSites = 0;
+
+    bool constructorKeepsInstance(const ModelDefinitionStatement *model);
+
+    bool isAllocation(Expression *expression) const;
+
+    void analyzeFunction(BlockStatement *body, const std::vector<std::unique_ptr<FunctionParameter>> &params);
+
+public:
+    explicit ArenaAllocation(const ModelAnalyzer &models) : models(models) {}
+
+    std::string name() const override {
+        return "arena-allocation";
+    }
+
+    void run(Program &program) override;
+
+    void printStatistics(std::ostream &os) const override;
+};
+
+
+#endif //BOSSCRIPT_ARENAALLOCATION_H
@@ -0,0 +1,209 @@
+#include "AsyncIO.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <stdexcept>
+
+#ifdef BOSSCRIPT_IO_URING
+#include <cerrno>
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// The submission and completion queues are shared with the kernel, which reads our tail and writes its head
+struct EventLoop::Ring {
+    int fd = -1;
+    void *sqMemory = MAP_FAILED;
+    size_t sqSize = 0;
+    void *cqMemory = MAP_FAILED;
+    size_t cqSize = 0;
+    io_uring_sqe *sqes = static_cast<io_uring_sqe *>(MAP_FAILED);
+    size_t sqesSize = 0;
+
+    unsigned *sqHead = nullptr;
+    unsigned *sqTail = nullptr;
+    unsigned sqMask = 0;
+    unsigned sqEntries = 0;
+    unsigned *sqArray = nullptr;
+    unsigned *cqHead = nullptr;
+    unsigned *cqTail = nullptr;
+    unsigned cqMask = 0;
+    unsigned cqEntries = 0;
+    io_uring_cqe *cqes = nullptr;
+
+    ~Ring() {
+        if (sqes != MAP_FAILED) munmap(sqes, sqesSize);
+        if (cqMemory != MAP_FAILED && cqMemory != sqMemory) munmap(cqMemory, cqSize);
+        if (sqMemory != MAP_FAILED) munmap(sqMemory, sqSize);
+        if (fd >= 0) close(fd);
+    }
+
+    static std::unique_ptr<Ring> create(unsigned entries) {
+        io_uring_params params{};
+        auto ring = std::make_unique<Ring>();
+        ring->fd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+        if (ring->fd < 0) {
+            return nullptr;
+        }
+
+        ring->sqSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        ring->cqSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        bool singleMap = params.features & IORING_FEAT_SINGLE_MMAP;
+        if (singleMap) {
+            ring->sqSize = ring->cqSize = std::max(ring->sqSize, ring->cqSize);
+        }
+        ring->sqMemory = mmap(nullptr, ring->sqSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQ_RING);
+        if (ring->sqMemory == MAP_FAILED) {
+            return nullptr;
+        }
+        ring->cqMemory = singleMap ? ring->sqMemory
+                                   : mmap(nullptr, ring->cqSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_CQ_RING);
+        if (ring->cqMemory == MAP_FAILED) {
+            return nullptr;
+        }
+        ring->sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+        ring->sqes = static_cast<io_uring_sqe *>(mmap(nullptr, ring->sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQES));
+        if (ring->sqes == MAP_FAILED) {
+            return nullptr;
+        }
+
+        auto sq = static_cast<char *>(ring->sqMemory);
+        ring->sqHead = reinterpret_cast<unsigned *>(sq + params.sq_off.head);
+        ring->sqTail = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+        ring->sqMask = *reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+        ring->sqEntries = params.sq_entries;
+        ring->sqArray = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+        auto cq = static_cast<char *>(ring->cqMemory);
+        ring->cqHead = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+        ring->cqTail = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+        ring->cqMask = *reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+        ring->cqEntries = params.cq_entries;
+        ring->cqes = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+        return ring;
+    }
+};
+
+EventLoop::EventLoop(unsigned entries) : ring(Ring::create(entries)) {
+    // Half of the fd limit is left to the rest of the process
+    rlimit files{};
+    size_t fdLimit = getrlimit(RLIMIT_NOFILE, &files) == 0 && files.rlim_cur != RLIM_INFINITY ? files.rlim_cur / 2 : entries;
+    maxRunning = std::max<size_t>(std::min<size_t>({entries, ring ? ring->cqEntries : entries, fdLimit}), 1);
+}
+
+bool EventLoop::ReadOperation::await_suspend(std::coroutine_handle<> handle) {
+    waiting = handle;
+    if (!loop.ring) {
+        result = pread(fd, buffer, length, static_cast<off_t>(offset));
+        if (result < 0) {
+            result = -errno;
+        }
+        return false;
+    }
+    loop.queued.push_back(this);
+    return true;
+}
+
+bool EventLoop::poll() {
+    if (queued.empty() && inFlight == 0) {
+        return false;
+    }
+
+    unsigned tail = *ring->sqTail;
+    while (!queued.empty() && inFlight < ring->cqEntries
+           && tail - std::atomic_ref<unsigned>(*ring->sqHead).load(std::memory_order_acquire) < ring->sqEntries) {
+        auto operation = queued.front();
+        queued.pop_front();
+        unsigned index = tail & ring->sqMask;
+        auto &sqe = ring->sqes[index];
+        std::memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = IORING_OP_READ;
+        sqe.fd = operation->fd;
+        sqe.addr = reinterpret_cast<uint64_t>(operation->buffer);
+        sqe.len = static_cast<uint32_t>(std::min<size_t>(operation->length, 1u << 30));
+        sqe.off = operation->offset;
+        sqe.user_data = reinterpret_cast<uint64_t>(operation);
+        ring->sqArray[index] = index;
+        tail++;
+        inFlight++;
+    }
+    std::atomic_ref<unsigned>(*ring->sqTail).store(tail, std::memory_order_release);
+    maxInFlight = std::max(maxInFlight, inFlight);
+
+    unsigned toSubmit = tail - std::atomic_ref<unsigned>(*ring->sqHead).load(std::memory_order_acquire);
+    if (syscall(__NR_io_uring_enter, ring->fd, toSubmit, 1, IORING_ENTER_GETEVENTS, nullptr, 0) < 0 && errno != EINTR) {
+        throw std::runtime_error(std::string("io_uring_enter: ") + std::strerror(errno));
+    }
+
+    // Coroutines are resumed after the completion queue is released, they can queue more reads
+    std::vector<ReadOperation *> finished;
+    unsigned head = *ring->cqHead;
+    unsigned completed = std::atomic_ref<unsigned>(*ring->cqTail).load(std::memory_order_acquire);
+    for (; head != completed; head++) {
+        auto &cqe = ring->cqes[head & ring->cqMask];
+        auto operation = reinterpret_cast<ReadOperation *>(cqe.user_data);
+        operation->result = cqe.res;
+        finished.push_back(operation);
+        inFlight--;
+    }
+    std::atomic_ref<unsigned>(*ring->cqHead).store(head, std::memory_order_release);
+
+    for (auto operation: finished) {
+        operation->waiting.resume();
+    }
+    return true;
+}
+
+Task<std::string> readFile(EventLoop &loop, std::string path) {
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    struct stat info{};
+    if (fd < 0 || fstat(fd, &info) < 0) {
+        if (fd >= 0) close(fd);
+        throw std::runtime_error("Nije moguće pročitati fajl '" + path + "'");
+    }
+
+    std::string content(static_cast<size_t>(info.st_size), '\0');
+    size_t offset = 0;
+    while (offset < content.size()) {
+        auto read = co_await loop.read(fd, content.data() + offset, content.size() - offset, offset);
+        if (read <= 0) {
+            close(fd);
+            throw std::runtime_error("Nije moguće pročitati fajl '" + path + "'");
+        }
+        offset += static_cast<size_t>(read);
+    }
+    close(fd);
+    co_return content;
+}
+
+#else
+#include <fstream>
+
+struct EventLoop::Ring {};
+
+EventLoop::EventLoop(unsigned) {}
+
+bool EventLoop::ReadOperation::await_suspend(std::coroutine_handle<>) {
+    // Without io_uring there is no raw file descriptor reading, readFile below does not suspend
+    result = -1;
+    return false;
+}
+
+bool EventLoop::poll() {
+    return false;
+}
+
+Task<std::string> readFile(EventLoop &, std::string path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Nije moguće pročitati fajl '" + path + "'");
+    }
+    co_return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+}
+
+#endif
+
+EventLoop::~EventLoop() = default;
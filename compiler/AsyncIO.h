@@ -0,0 +1,199 @@
+#ifndef BOSSCRIPT_ASYNCIO_H
+#define BOSSCRIPT_ASYNCIO_H
+
+#include <coroutine>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define BOSSCRIPT_IO_URING 1
+#endif
+
+// Coroutine producing a T. It starts when it is awaited (or started by an event loop) and resumes its
+// awaiter when it finishes
+template<typename T>
+class Task {
+public:
+    class promise_type {
+    public:
+        std::optional<T> value;
+        std::exception_ptr error;
+        std::coroutine_handle<> continuation;
+
+        Task get_return_object() {
+            return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() noexcept {
+            return {};
+        }
+
+        auto final_suspend() noexcept {
+            struct ResumeAwaiter {
+                bool await_ready() noexcept {
+                    return false;
+                }
+
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept {
+                    auto continuation = handle.promise().continuation;
+                    return continuation ? continuation : std::noop_coroutine();
+                }
+
+                void await_resume() noexcept {}
+            };
+            return ResumeAwaiter{};
+        }
+
+        void return_value(T result) {
+            value = std::move(result);
+        }
+
+        void unhandled_exception() {
+            error = std::current_exception();
+        }
+    };
+
+private:
+    std::coroutine_handle<promise_type> handle;
+
+    explicit Task(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+
+public:
+    Task(Task &&other) noexcept : handle(std::exchange(other.handle, {})) {}
+
+    Task(const Task &) = delete;
+
+    Task &operator=(const Task &) = delete;
+
+    ~Task() {
+        if (handle) {
+            handle.destroy();
+        }
+    }
+
+    // Runs the coroutine until it first suspends, for tasks nobody awaits
+    void start() {
+        handle.resume();
+    }
+
+    bool done() const {
+        return handle.done();
+    }
+
+    // Rethrows what the coroutine threw
+    T &result() {
+        if (handle.promise().error) {
+            std::rethrow_exception(handle.promise().error);
+        }
+        return *handle.promise().value;
+    }
+
+    bool await_ready() const noexcept {
+        return false;
+    }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+        handle.promise().continuation = awaiting;
+        return handle;
+    }
+
+    T await_resume() {
+        return std::move(result());
+    }
+};
+
+// Single-threaded event loop for file reads. On Linux the reads go through io_uring: a coroutine awaiting
+// a read is suspended until the kernel completes it, so one thread keeps hundreds of reads in flight.
+// Elsewhere, or when the kernel does not allow io_uring, reads complete synchronously.
+class EventLoop {
+public:
+    class ReadOperation {
+    private:
+        EventLoop &loop;
+        int fd;
+        char *buffer;
+        size_t length;
+        uint64_t offset;
+        int64_t result = 0;
+        std::coroutine_handle<> waiting;
+
+        friend class EventLoop;
+
+    public:
+        ReadOperation(EventLoop &loop, int fd, char *buffer, size_t length, uint64_t offset)
+                : loop(loop), fd(fd), buffer(buffer), length(length), offset(offset) {}
+
+        bool await_ready() const noexcept {
+            return false;
+        }
+
+        bool await_suspend(std::coroutine_handle<> handle);
+
+        // Bytes read, or a negative errno
+        int64_t await_resume() const noexcept {
+            return result;
+        }
+    };
+
+private:
+    struct Ring;
+    std::unique_ptr<Ring> ring;
+    // Reads waiting for room in the ring, which never has more in flight than its completion queue holds
+    std::deque<ReadOperation *> queued;
+    size_t inFlight = 0;
+    size_t maxInFlight = 0;
+    // Tasks run returns to at once. Each holds an open file, so this stays within the ring and the fd limit
+    size_t maxRunning = 1;
+
+    // Submits queued reads, waits for at least one completion and resumes the finished coroutines.
+    // Returns false when nothing is queued or in flight
+    bool poll();
+
+public:
+    explicit EventLoop(unsigned entries = 256);
+
+    ~EventLoop();
+
+    EventLoop(const EventLoop &) = delete;
+
+    EventLoop &operator=(const EventLoop &) = delete;
+
+    bool usesRing() const {
+        return ring != nullptr;
+    }
+
+    size_t peakInFlight() const {
+        return maxInFlight;
+    }
+
+    ReadOperation read(int fd, char *buffer, size_t length, uint64_t offset) {
+        return {*this, fd, buffer, length, offset};
+    }
+
+    // Runs every task and returns once all of them have finished. A task is only started when one of the
+    // maxRunning before it has finished. Every task still running is waiting for a read, so when nothing
+    // is queued or in flight they have all finished
+    template<typename T>
+    void run(std::vector<Task<T>> &tasks) {
+        size_t next = 0;
+        std::vector<Task<T> *> running;
+        do {
+            std::erase_if(running, [](Task<T> *task) { return task->done(); });
+            while (next < tasks.size() && running.size() < maxRunning) {
+                running.push_back(&tasks[next++]);
+                running.back()->start();
+            }
+        } while (poll() || next < tasks.size());
+    }
+};
+
+Task<std::string> readFile(EventLoop &loop, std::string path);
+
+
+#endif //BOSSCRIPT_ASYNCIO_H
@@ -0,0 +1,113 @@
+#include "Bindings.h"
+#include "../parser/AST/ASTWalker.h"
+
+std::set<std::string> Bindings::boundNames(Statement *node) {
+    std::set<std::string> names = assignedNames(node);
+    ASTWalker::walk(node, [&names](Statement *statement) {
+        switch (statement->kind) {
+            case NodeType::VariableDeclaration:
+                names.insert(static_cast<VariableDeclaration *>(statement)->name);
+                break;
+            case NodeType::FunctionParameter:
+                names.insert(static_cast<FunctionParameter *>(statement)->identifier->symbol);
+                break;
+            case NodeType::FunctionDeclaration:
+                names.insert(static_cast<FunctionDeclaration *>(statement)->name->symbol);
+                break;
+            case NodeType::ForStatement:
+                names.insert(static_cast<ForStatement *>(statement)->counter->symbol);
+                break;
+            case NodeType::ForEachStatement:
+                names.insert(static_cast<ForEachStatement *>(statement)->element->symbol);
+                break;
+            default:
+                break;
+        }
+        return true;
+    });
+    return names;
+}
+
+std::set<std::string> Bindings::assignedNames(Statement *node) {
+    std::set<std::string> names;
+    ASTWalker::walk(node, [&names](Statement *statement) {
+        if (statement->kind == NodeType::AssignmentExpression) {
+            auto assignee = static_cast<AssignmentExpression *>(statement)->assignee.get();
+            if (assignee->kind == NodeType::Identifier) {
+                names.insert(static_cast<Identifier *>(assignee)->symbol);
+            }
+        }
+        else if (statement->kind == NodeType::UnaryExpression) {
+            auto expression = static_cast<UnaryExpression *>(statement);
+            if ((expression->mOperator == "++" || expression->mOperator == "--") && expression->operand->kind == NodeType::Identifier) {
+                names.insert(static_cast<Identifier *>(expression->operand.get())->symbol);
+            }
+        }
+        return true;
+    });
+    return names;
+}
+
+std::set<std::string> Bindings::escapingNames(Statement *body) {
+    std::set<std::string> names;
+
+    auto isNestedFunction = [](Statement *statement) {
+        return statement->kind == NodeType::FunctionDeclaration || statement->kind == NodeType::FunctionExpression
+               || statement->kind == NodeType::ModelDefinition;
+    };
+
+    std::function<void(Statement *, bool)> scan = [&](Statement *node, bool nested) {
+        ASTWalker::walk(node, [&](Statement *statement) {
+            if (isNestedFunction(statement) && statement != node) {
+                scan(statement, true);
+                return false;
+            }
+            switch (statement->kind) {
+                case NodeType::Identifier:
+                    names.insert(static_cast<Identifier *>(statement)->symbol);
+                    return false;
+                case NodeType::VariableDeclaration:
+                    if (nested) names.insert(static_cast<VariableDeclaration *>(statement)->name);
+                    return true;
+                case NodeType::FunctionParameter:
+                    names.insert(static_cast<FunctionParameter *>(statement)->identifier->symbol);
+                    return false;
+                case NodeType::CallExpression: {
+                    // The method receives the object as @ and may keep it
+                    auto callee = static_cast<CallExpression *>(statement)->callee.get();
+                    if (callee->kind == NodeType::MemberExpression) {
+                        auto target = static_cast<MemberExpression *>(callee)->targetObject.get();
+                        if (target->kind == NodeType::Identifier) {
+                            names.insert(static_cast<Identifier *>(target)->symbol);
+                        }
+                    }
+                    return true;
+                }
+                case NodeType::MemberExpression: {
+                    auto member = static_cast<MemberExpression *>(statement);
+                    if (nested || member->targetObject->kind != NodeType::Identifier) {
+                        scan(member->targetObject.get(), nested);
+                    }
+                    if (member->isComputed) {
+                        scan(member->property.get(), nested);
+                    }
+                    return false;
+                }
+                case NodeType::ForEachStatement: {
+                    // Iterating over an array only reads its elements
+                    auto loop = static_cast<ForEachStatement *>(statement);
+                    names.insert(loop->element->symbol);
+                    if (nested || loop->iterable->kind != NodeType::Identifier) {
+                        scan(loop->iterable.get(), nested);
+                    }
+                    scan(loop->body.get(), nested);
+                    return false;
+                }
+                default:
+                    return true;
+            }
+        });
+    };
+    scan(body, false);
+    return names;
+}
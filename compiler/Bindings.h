@@ -0,0 +1,24 @@
+#ifndef BOSSCRIPT_BINDINGS_H
+#define BOSSCRIPT_BINDINGS_H
+
+#include <set>
+#include <string>
+#include "../parser/AST/Statements.h"
+
+class Bindings {
+public:
+    // Names declared, assigned, incremented or used as parameters/loop counters anywhere inside node,
+    // including nested functions
+    static std::set<std::string> boundNames(Statement *node);
+
+    // Names assigned or incremented anywhere inside node. Declarations with an initializer are not counted
+    static std::set<std::string> assignedNames(Statement *node);
+
+    // Names in a function body that are used for anything other than the target of a property or element
+    // access or the array of a for-each loop: passed, returned, stored, reassigned, used to call a method
+    // or mentioned in a nested function
+    static std::set<std::string> escapingNames(Statement *body);
+};
+
+
+#endif //BOSSCRIPT_BINDINGS_H
@@ -0,0 +1,63 @@
+#ifndef BOSSCRIPT_CHANNEL_H
+#define BOSSCRIPT_CHANNEL_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <optional>
+
+// Bounded FIFO between threads. Messages are moved in and out, so a message that owns its data (a vector,
+// a unique_ptr, a shared_ptr to immutable data) changes owner without its contents being copied.
+// send blocks while the channel is full, receive while it is empty.
+template<typename T>
+class Channel {
+private:
+    std::mutex mutex;
+    std::condition_variable notFull;
+    std::condition_variable notEmpty;
+    std::deque<T> messages;
+    size_t capacity;
+    bool closed = false;
+
+public:
+    explicit Channel(size_t capacity = 64) : capacity(capacity) {}
+
+    // Returns false if the channel was closed, the message is dropped then
+    bool send(T message) {
+        std::unique_lock<std::mutex> lock(mutex);
+        notFull.wait(lock, [this]() { return messages.size() < capacity || closed; });
+        if (closed) {
+            return false;
+        }
+        messages.push_back(std::move(message));
+        lock.unlock();
+        notEmpty.notify_one();
+        return true;
+    }
+
+    // Returns nullopt once the channel is closed and every message sent before that was received
+    std::optional<T> receive() {
+        std::unique_lock<std::mutex> lock(mutex);
+        notEmpty.wait(lock, [this]() { return !messages.empty() || closed; });
+        if (messages.empty()) {
+            return std::nullopt;
+        }
+        T message = std::move(messages.front());
+        messages.pop_front();
+        lock.unlock();
+        notFull.notify_one();
+        return message;
+    }
+
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            closed = true;
+        }
+        notFull.notify_all();
+        notEmpty.notify_all();
+    }
+};
+
+
+#endif //BOSSCRIPT_CHANNEL_H
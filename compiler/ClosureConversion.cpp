@@ -0,0 +1,264 @@
+#include "ClosureConversion.h"
+#include "../parser/AST/ASTWalker.h"
+#include <algorithm>
+
+void ClosureConversion::run(Program &program) {
+    functions.push_back(Function{&program, 0, {}});
+    scopes.push_back(Scope{0, ++position, {}});
+    visitBlock(program.body);
+    scopes.pop_back();
+    functions.pop_back();
+
+    for (auto &binding: bindings) {
+        if (binding.captures.empty() || isCopiedByValue(binding)) {
+            continue;
+        }
+        for (auto declaration: binding.declarations) {
+            switch (binding.kind) {
+                case BindingKind::Variable:
+                    static_cast<VariableDeclaration *>(declaration)->inCell = true;
+                    break;
+                case BindingKind::Parameter:
+                    static_cast<FunctionParameter *>(declaration)->inCell = true;
+                    break;
+                case BindingKind::Counter:
+                    static_cast<ForStatement *>(declaration)->counterInCell = true;
+                    break;
+                case BindingKind::Element:
+                    static_cast<ForEachStatement *>(declaration)->elementInCell = true;
+                    break;
+                case BindingKind::Function:
+                    static_cast<FunctionDeclaration *>(declaration)->nameInCell = true;
+                    break;
+                case BindingKind::Model:
+                    static_cast<ModelDefinitionStatement *>(declaration)->nameInCell = true;
+                    break;
+            }
+        }
+        cells++;
+    }
+
+    for (const auto &[node, captured]: captures) {
+        std::vector<CapturedVariable> list;
+        for (auto binding: captured) {
+            bool byValue = isCopiedByValue(*binding);
+            list.push_back(CapturedVariable{binding->name, byValue});
+            byValue ? copied++ : shared++;
+        }
+        if (node->kind == NodeType::FunctionExpression) {
+            static_cast<FunctionExpression *>(node)->captures = std::move(list);
+        } else {
+            static_cast<FunctionDeclaration *>(node)->captures = std::move(list);
+        }
+        closures++;
+    }
+}
+
+void ClosureConversion::printStatistics(std::ostream &os) const {
+    os << "Closures: " << closures << " functions capture " << copied + shared << " variables (" << copied
+       << " by value, " << shared << " through cells), " << cells << " variables in cells" << std::endl;
+}
+
+bool ClosureConversion::isCopiedByValue(const Binding &binding) {
+    if (binding.kind == BindingKind::Counter || binding.assigned || !binding.position) {
+        return false;
+    }
+    return std::all_of(binding.captures.begin(), binding.captures.end(), [&binding](size_t createdAt) {
+        return createdAt > *binding.position;
+    });
+}
+
+ClosureConversion::Binding *ClosureConversion::declare(const std::string &name, BindingKind kind, Statement *declaration) {
+    Scope &scope = scopes.back();
+    auto existing = scope.names.find(name);
+    if (existing != scope.names.end()) {
+        // Declared twice in one scope, the second declaration overwrites the first
+        existing->second->assigned = true;
+        existing->second->declarations.push_back(declaration);
+        return existing->second;
+    }
+    bindings.push_back(Binding{name, kind, scope.function, std::nullopt, false, {}, {declaration}});
+    scope.names[name] = &bindings.back();
+    return &bindings.back();
+}
+
+void ClosureConversion::hoist(const std::vector<std::unique_ptr<Statement>> &body) {
+    for (const auto &statement: body) {
+        if (statement->kind == NodeType::VariableStatement) {
+            for (const auto &declaration: static_cast<VariableStatement *>(statement.get())->declarations) {
+                declare(declaration->name, BindingKind::Variable, declaration.get());
+            }
+        }
+        else if (statement->kind == NodeType::FunctionDeclaration) {
+            declare(static_cast<FunctionDeclaration *>(statement.get())->name->symbol, BindingKind::Function, statement.get());
+        }
+        else if (statement->kind == NodeType::ModelDefinition) {
+            declare(static_cast<ModelDefinitionStatement *>(statement.get())->className->symbol, BindingKind::Model, statement.get());
+        }
+    }
+}
+
+ClosureConversion::Binding *ClosureConversion::resolve(const std::string &name) {
+    for (auto scope = scopes.rbegin(); scope != scopes.rend(); ++scope) {
+        auto binding = scope->names.find(name);
+        if (binding != scope->names.end()) {
+            return binding->second;
+        }
+    }
+    return nullptr;
+}
+
+void ClosureConversion::visitBlock(const std::vector<std::unique_ptr<Statement>> &body) {
+    hoist(body);
+    for (const auto &statement: body) {
+        visit(statement.get());
+    }
+}
+
+void ClosureConversion::visitFunction(Statement *node, const std::vector<std::unique_ptr<FunctionParameter>> &params,
+                                      BlockStatement *body, size_t createdAt) {
+    functions.push_back(Function{node, createdAt, {}});
+    scopes.push_back(Scope{functions.size() - 1, ++position, {}});
+    for (const auto &param: params) {
+        declare(param->identifier->symbol, BindingKind::Parameter, param.get())->position = position;
+    }
+    visit(body);
+    scopes.pop_back();
+
+    if (!functions.back().captures.empty()) {
+        captures[node] = functions.back().captures;
+    }
+    functions.pop_back();
+}
+
+void ClosureConversion::visit(Statement *node) {
+    // Finds the binding a declaration statement introduced, declaring it if it was not hoisted
+    auto declared = [this](const std::string &name, BindingKind kind, Statement *declaration) {
+        auto binding = scopes.back().names.find(name);
+        Binding *result = binding != scopes.back().names.end() ? binding->second : declare(name, kind, declaration);
+        if (result->position) {
+            result->assigned = true;
+        }
+        return result;
+    };
+
+    switch (node->kind) {
+        case NodeType::Block:
+            scopes.push_back(Scope{functions.size() - 1, ++position, {}});
+            visitBlock(static_cast<BlockStatement *>(node)->body);
+            scopes.pop_back();
+            return;
+        case NodeType::VariableStatement:
+            for (const auto &declaration: static_cast<VariableStatement *>(node)->declarations) {
+                if (declaration->value) {
+                    visit(declaration->value.get());
+                }
+                declared(declaration->name, BindingKind::Variable, declaration.get())->position = ++position;
+            }
+            return;
+        case NodeType::FunctionDeclaration: {
+            auto function = static_cast<FunctionDeclaration *>(node);
+            // Declarations are created when their block is entered, before any statement of the block runs
+            size_t createdAt = scopes.back().position;
+            declared(function->name->symbol, BindingKind::Function, function)->position = ++position;
+            visitFunction(function, function->params, function->body.get(), createdAt);
+            return;
+        }
+        case NodeType::FunctionExpression: {
+            auto function = static_cast<FunctionExpression *>(node);
+            visitFunction(function, function->params, function->body.get(), ++position);
+            return;
+        }
+        case NodeType::ModelDefinition: {
+            // Constructor and methods are created before the model's name is bound
+            auto model = static_cast<ModelDefinitionStatement *>(node);
+            size_t createdAt = ++position;
+            declared(model->className->symbol, BindingKind::Model, model)->position = ++position;
+            visitFunction(model->constructor.get(), model->constructor->params, model->constructor->body.get(), createdAt);
+            for (auto block: {model->privateBlock.get(), model->publicBlock.get()}) {
+                if (!block) continue;
+                for (const auto &member: block->getBody()) {
+                    if (member->kind == NodeType::FunctionDeclaration) {
+                        auto method = static_cast<FunctionDeclaration *>(member.get());
+                        visitFunction(method, method->params, method->body.get(), createdAt);
+                    } else if (member->kind == NodeType::VariableStatement) {
+                        // Fields are not variables, only their initializers are visited
+                        for (const auto &field: static_cast<VariableStatement *>(member.get())->declarations) {
+                            if (field->value) visit(field->value.get());
+                        }
+                    }
+                }
+            }
+            return;
+        }
+        case NodeType::ForStatement: {
+            // The counter is one variable advanced in place for the whole loop, not a new binding per iteration.
+            // Closures created in different iterations share its cell and all see its latest value; the body has
+            // to copy it (var k = i) to keep the value of one iteration
+            auto loop = static_cast<ForStatement *>(node);
+            for (auto bound: {loop->startValue.get(), loop->endValue.get(), loop->step.get()}) {
+                if (bound) visit(bound);
+            }
+            scopes.push_back(Scope{functions.size() - 1, ++position, {}});
+            declare(loop->counter->symbol, BindingKind::Counter, loop)->position = position;
+            visit(loop->body.get());
+            scopes.pop_back();
+            return;
+        }
+        case NodeType::ForEachStatement: {
+            // Every iteration binds a new element, so closures can copy it unless the body assigns it
+            auto loop = static_cast<ForEachStatement *>(node);
+            visit(loop->iterable.get());
+            scopes.push_back(Scope{functions.size() - 1, ++position, {}});
+            declare(loop->element->symbol, BindingKind::Element, loop)->position = position;
+            visit(loop->body.get());
+            scopes.pop_back();
+            return;
+        }
+        case NodeType::Identifier: {
+            auto binding = resolve(static_cast<Identifier *>(node)->symbol);
+            size_t current = functions.size() - 1;
+            if (!binding || binding->function == 0 || binding->function == current) {
+                return;
+            }
+            // Every function between the declaring one and this one needs the variable in its closure
+            for (size_t function = binding->function + 1; function <= current; function++) {
+                auto &list = functions[function].captures;
+                if (std::find(list.begin(), list.end(), binding) == list.end()) {
+                    list.push_back(binding);
+                    binding->captures.push_back(functions[function].position);
+                }
+            }
+            return;
+        }
+        case NodeType::MemberExpression: {
+            auto member = static_cast<MemberExpression *>(node);
+            visit(member->targetObject.get());
+            if (member->isComputed) {
+                visit(member->property.get());
+            }
+            return;
+        }
+        case NodeType::AssignmentExpression:
+        case NodeType::UnaryExpression: {
+            Expression *target = nullptr;
+            if (node->kind == NodeType::AssignmentExpression) {
+                target = static_cast<AssignmentExpression *>(node)->assignee.get();
+            } else if (static_cast<UnaryExpression *>(node)->mOperator == "++" || static_cast<UnaryExpression *>(node)->mOperator == "--") {
+                target = static_cast<UnaryExpression *>(node)->operand.get();
+            }
+            if (target && target->kind == NodeType::Identifier) {
+                if (auto binding = resolve(static_cast<Identifier *>(target)->symbol)) {
+                    binding->assigned = true;
+                }
+            }
+            break;
+        }
+        default:
+            break;
+    }
+
+    ASTWalker::forEachChild(node, [this](Statement *child) {
+        visit(child);
+    });
+}
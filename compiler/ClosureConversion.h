@@ -0,0 +1,91 @@
+#ifndef BOSSCRIPT_CLOSURECONVERSION_H
+#define BOSSCRIPT_CLOSURECONVERSION_H
+
+#include <deque>
+#include <map>
+#include <set>
+#include "Pass.h"
+
+// Resolves every name to its declaration and gives each function the flat list of variables it uses
+// from enclosing functions, so a closure is a single allocation holding its captures instead of a link
+// to the whole environment chain. A function nested two levels deep also passes captures through its
+// parent. Names declared at the top level of the program are globals and are never captured.
+//
+// A capture is copied by value when the variable is never assigned after its declaration (konst or not)
+// and is declared before the closure is created. Function declarations count as created when their block
+// is entered. Other captured variables, loop counters and function names live in a cell shared by the
+// declaring function and its closures. A counted loop has one counter for all of its iterations, so closures
+// created in the loop see the counter's current value, while each for-each iteration binds a new element.
+class ClosureConversion : public Pass {
+private:
+    enum class BindingKind {
+        Variable,
+        Parameter,
+        Counter,
+        Element,
+        Function,
+        Model
+    };
+
+    class Binding {
+    public:
+        std::string name;
+        BindingKind kind;
+        size_t function;
+        std::optional<size_t> position;
+        bool assigned = false;
+        // Creation position of every closure capturing the binding
+        std::vector<size_t> captures;
+        std::vector<Statement *> declarations;
+    };
+
+    class Scope {
+    public:
+        size_t function;
+        size_t position;
+        std::map<std::string, Binding *> names;
+    };
+
+    class Function {
+    public:
+        Statement *node;
+        size_t position;
+        std::vector<Binding *> captures;
+    };
+
+    std::deque<Binding> bindings;
+    std::vector<Scope> scopes;
+    std::vector<Function> functions;
+    std::map<Statement *, std::vector<Binding *>> captures;
+    size_t position = 0;
+    size_t closures = 0;
+    size_t copied = 0;
+    size_t shared = 0;
+    size_t cells = 0;
+
+    Binding *declare(const std::string &name, BindingKind kind, Statement *declaration);
+
+    void hoist(const std::vector<std::unique_ptr<Statement>> &body);
+
+    Binding *resolve(const std::string &name);
+
+    void visit(Statement *node);
+
+    void visitFunction(Statement *node, const std::vector<std::unique_ptr<FunctionParameter>> &params, BlockStatement *body, size_t createdAt);
+
+    void visitBlock(const std::vector<std::unique_ptr<Statement>> &body);
+
+    static bool isCopiedByValue(const Binding &binding);
+
+public:
+    std::string name() const override {
+        return "closures";
+    }
+
+    void run(Program &program) override;
+
+    void printStatistics(std::ostream &os) const override;
+};
+
+
+#endif //BOSSCRIPT_CLOSURECONVERSION_H
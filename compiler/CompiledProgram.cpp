@@ -0,0 +1,47 @@
+#include "CompiledProgram.h"
+#include "InlineCacheBuilder.h"
+#include "../parser/Parser.h"
+
+std::shared_ptr<const CompiledProgram> CompiledProgram::compile(const std::string &source) {
+    Parser parser(false);
+    std::shared_ptr<CompiledProgram> compiled(new CompiledProgram(parser.parseProgram(source)));
+    compiled->compiler.compile(compiled->program);
+    return compiled;
+}
+
+InlineCaches CompiledProgram::createInlineCaches() const {
+    return static_cast<const InlineCacheBuilder *>(compiler.pass("inline-caches"))->seeds();
+}
+
+std::shared_ptr<const CompiledProgram> ProgramCache::get(const std::string &source) {
+    std::promise<std::shared_ptr<const CompiledProgram>> promise;
+    std::shared_future<std::shared_ptr<const CompiledProgram>> program;
+    bool owner = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto existing = programs.find(source);
+        if (existing != programs.end()) {
+            program = existing->second;
+        } else {
+            program = promise.get_future().share();
+            programs.emplace(source, program);
+            compilations++;
+            owner = true;
+        }
+    }
+
+    // Compiled outside the lock, so threads asking for other sources are not blocked
+    if (owner) {
+        try {
+            promise.set_value(CompiledProgram::compile(source));
+        } catch (...) {
+            promise.set_exception(std::current_exception());
+        }
+    }
+    return program.get();
+}
+
+size_t ProgramCache::compiled() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return compilations;
+}
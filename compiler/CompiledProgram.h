@@ -0,0 +1,52 @@
+#ifndef BOSSCRIPT_COMPILEDPROGRAM_H
+#define BOSSCRIPT_COMPILEDPROGRAM_H
+
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "Compiler.h"
+#include "InlineCache.h"
+
+// A parsed program after every compiler pass has run. Nothing modifies it afterwards, so a single instance
+// is shared read-only by all threads running the program, each with its own execution state.
+class CompiledProgram {
+private:
+    Program program;
+    Compiler compiler;
+
+    explicit CompiledProgram(Program program) : program(std::move(program)) {}
+
+public:
+    static std::shared_ptr<const CompiledProgram> compile(const std::string &source);
+
+    const Program &getProgram() const {
+        return program;
+    }
+
+    const Compiler &getCompiler() const {
+        return compiler;
+    }
+
+    // Inline caches for one execution of the program, owned by the thread running it
+    InlineCaches createInlineCaches() const;
+};
+
+// Compiles each distinct source once per process. Threads asking for a source that is being compiled
+// wait for that compilation instead of starting their own. A source that fails to compile keeps
+// failing with the same error.
+class ProgramCache {
+private:
+    std::mutex mutex;
+    std::unordered_map<std::string, std::shared_future<std::shared_ptr<const CompiledProgram>>> programs;
+    size_t compilations = 0;
+
+public:
+    std::shared_ptr<const CompiledProgram> get(const std::string &source);
+
+    size_t compiled();
+};
+
+
+#endif //BOSSCRIPT_COMPILEDPROGRAM_H
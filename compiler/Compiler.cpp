@@ -0,0 +1,61 @@
+#include "Compiler.h"
+#include "ConstantFolding.h"
+#include "ModelAnalyzer.h"
+#include "ClosureConversion.h"
+#include "TailCalls.h"
+#include "ParallelLoops.h"
+#include "Safepoints.h"
+#include "ScalarReplacement.h"
+#include "ArenaAllocation.h"
+#include "CountedLoops.h"
+#include "SmallIntegers.h"
+#include "ElementKinds.h"
+#include "InlineCacheBuilder.h"
+#include "StringInterning.h"
+#include "../parser/AST/ASTPrinter.h"
+
+Compiler::Compiler() {
+    auto models = std::make_unique<ModelAnalyzer>();
+    const ModelAnalyzer &modelInfo = *models;
+
+    passes.emplace_back(std::make_unique<ConstantFolding>());
+    passes.emplace_back(std::move(models));
+    passes.emplace_back(std::make_unique<ScalarReplacement>(modelInfo));
+    passes.emplace_back(std::make_unique<ArenaAllocation>(modelInfo));
+    passes.emplace_back(std::make_unique<CountedLoops>());
+    passes.emplace_back(std::make_unique<SmallIntegers>());
+    passes.emplace_back(std::make_unique<ElementKinds>());
+    passes.emplace_back(std::make_unique<InlineCacheBuilder>(modelInfo));
+    passes.emplace_back(std::make_unique<StringInterning>());
+    passes.emplace_back(std::make_unique<ClosureConversion>());
+    passes.emplace_back(std::make_unique<TailCalls>());
+    passes.emplace_back(std::make_unique<ParallelLoops>());
+    passes.emplace_back(std::make_unique<Safepoints>());
+}
+
+void Compiler::compile(Program &program) {
+    if (dump) {
+        *dump << "=== Before passes ===" << std::endl << ASTPrinter::print(&program);
+    }
+    for (const auto &pass: passes) {
+        pass->run(program);
+        if (dump) {
+            *dump << "=== After " << pass->name() << " ===" << std::endl << ASTPrinter::print(&program);
+        }
+    }
+}
+
+const Pass *Compiler::pass(const std::string &name) const {
+    for (const auto &pass: passes) {
+        if (pass->name() == name) {
+            return pass.get();
+        }
+    }
+    return nullptr;
+}
+
+void Compiler::printStatistics(std::ostream &os) const {
+    for (const auto &pass: passes) {
+        pass->printStatistics(os);
+    }
+}
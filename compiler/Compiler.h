@@ -0,0 +1,31 @@
+#ifndef BOSSCRIPT_COMPILER_H
+#define BOSSCRIPT_COMPILER_H
+
+#include <memory>
+#include <vector>
+#include <ostream>
+#include "Pass.h"
+
+// Runs the compiler passes over a parsed program, in order
+class Compiler {
+private:
+    std::vector<std::unique_ptr<Pass>> passes;
+    std::ostream *dump = nullptr;
+
+public:
+    Compiler();
+
+    // Prints the program before the first pass and after every pass
+    void dumpPasses(std::ostream &os) {
+        dump = &os;
+    }
+
+    void compile(Program &program);
+
+    const Pass *pass(const std::string &name) const;
+
+    void printStatistics(std::ostream &os) const;
+};
+
+
+#endif //BOSSCRIPT_COMPILER_H
@@ -0,0 +1,196 @@
+#include "ConstantFolding.h"
+#include "NumericValue.h"
+#include "../parser/AST/ASTWalker.h"
+#include <cmath>
+
+void ConstantFolding::run(Program &program) {
+    size_t before = countNodes(&program);
+
+    ASTWalker::rewriteExpressions(&program, [this](std::unique_ptr<Expression> &expression) {
+        fold(expression);
+    });
+    prune(&program);
+
+    removedNodes += before - countNodes(&program);
+}
+
+void ConstantFolding::printStatistics(std::ostream &os) const {
+    os << "Constant folding: " << foldedExpressions << " expressions folded, " << prunedBranches
+       << " branches pruned, " << removedNodes << " nodes removed" << std::endl;
+}
+
+size_t ConstantFolding::countNodes(Statement *node) {
+    size_t count = 0;
+    ASTWalker::walk(node, [&count](Statement *) {
+        count++;
+        return true;
+    });
+    return count;
+}
+
+void ConstantFolding::fold(std::unique_ptr<Expression> &expression) {
+    std::unique_ptr<Expression> folded;
+    switch (expression->kind) {
+        case NodeType::BinaryExpression:
+            folded = foldBinary(static_cast<BinaryExpression *>(expression.get()));
+            break;
+        case NodeType::LogicalExpression:
+            folded = foldLogical(static_cast<LogicalExpression *>(expression.get()));
+            break;
+        case NodeType::UnaryExpression:
+            folded = foldUnary(static_cast<UnaryExpression *>(expression.get()));
+            break;
+        default:
+            break;
+    }
+    if (folded) {
+        expression = std::move(folded);
+        foldedExpressions++;
+    }
+}
+
+std::unique_ptr<Expression> ConstantFolding::foldBinary(BinaryExpression *binary) {
+    const std::string &op = binary->mOperator;
+    auto leftKind = binary->left->kind;
+    auto rightKind = binary->right->kind;
+
+    if (leftKind == NodeType::NumericLiteral && rightKind == NodeType::NumericLiteral) {
+        auto left = NumericValue::of(static_cast<NumericLiteral *>(binary->left.get())->value);
+        auto right = NumericValue::of(static_cast<NumericLiteral *>(binary->right.get())->value);
+
+        if (auto result = NumericValue::compare(op, left, right)) {
+            return std::make_unique<BooleanLiteral>(*result);
+        }
+
+        if ((op == "/" || op == "%") && right.toDouble() == 0) {
+            return nullptr;
+        }
+        auto result = NumericValue::apply(op, left, right);
+        if (!result || !std::isfinite(result->toDouble())) {
+            return nullptr;
+        }
+        return std::make_unique<NumericLiteral>(result->toDouble());
+    }
+
+    if (leftKind == NodeType::StringLiteral && rightKind == NodeType::StringLiteral) {
+        const std::string &left = static_cast<StringLiteral *>(binary->left.get())->value;
+        const std::string &right = static_cast<StringLiteral *>(binary->right.get())->value;
+        if (op == "+") return std::make_unique<StringLiteral>(left + right);
+        if (op == "==") return std::make_unique<BooleanLiteral>(left == right);
+        if (op == "!=") return std::make_unique<BooleanLiteral>(left != right);
+        return nullptr;
+    }
+
+    if (leftKind == NodeType::BooleanLiteral && rightKind == NodeType::BooleanLiteral) {
+        bool left = static_cast<BooleanLiteral *>(binary->left.get())->value;
+        bool right = static_cast<BooleanLiteral *>(binary->right.get())->value;
+        if (op == "==") return std::make_unique<BooleanLiteral>(left == right);
+        if (op == "!=") return std::make_unique<BooleanLiteral>(left != right);
+    }
+
+    return nullptr;
+}
+
+std::unique_ptr<Expression> ConstantFolding::foldLogical(LogicalExpression *logical) {
+    if (logical->left->kind != NodeType::BooleanLiteral) {
+        return nullptr;
+    }
+    bool left = static_cast<BooleanLiteral *>(logical->left.get())->value;
+
+    // A short-circuiting left operand decides the result without evaluating the right one
+    if (logical->mOperator == "&&" && !left) return std::make_unique<BooleanLiteral>(false);
+    if (logical->mOperator == "||" && left) return std::make_unique<BooleanLiteral>(true);
+
+    if (logical->right->kind == NodeType::BooleanLiteral) {
+        return std::make_unique<BooleanLiteral>(static_cast<BooleanLiteral *>(logical->right.get())->value);
+    }
+    return nullptr;
+}
+
+std::unique_ptr<Expression> ConstantFolding::foldUnary(UnaryExpression *unary) {
+    auto operand = unary->operand.get();
+    if (operand->kind == NodeType::NumericLiteral) {
+        double value = static_cast<NumericLiteral *>(operand)->value;
+        if (unary->mOperator == "-") return std::make_unique<NumericLiteral>(-value);
+        if (unary->mOperator == "+") return std::make_unique<NumericLiteral>(value);
+    }
+    if (operand->kind == NodeType::BooleanLiteral && unary->mOperator == "!") {
+        return std::make_unique<BooleanLiteral>(!static_cast<BooleanLiteral *>(operand)->value);
+    }
+    return nullptr;
+}
+
+void ConstantFolding::prune(Statement *node) {
+    switch (node->kind) {
+        case NodeType::Program:
+            pruneList(static_cast<Program *>(node)->body);
+            break;
+        case NodeType::Block:
+            pruneList(static_cast<BlockStatement *>(node)->body);
+            break;
+        case NodeType::IfStatement: {
+            auto ifStatement = static_cast<IfStatement *>(node);
+            pruneSlot(ifStatement->consequent);
+            pruneSlot(ifStatement->alternate);
+            break;
+        }
+        case NodeType::UnlessStatement: {
+            auto unless = static_cast<UnlessStatement *>(node);
+            pruneSlot(unless->consequent);
+            pruneSlot(unless->alternate);
+            break;
+        }
+        default:
+            ASTWalker::forEachChild(node, [this](Statement *child) {
+                prune(child);
+            });
+            break;
+    }
+}
+
+void ConstantFolding::pruneSlot(std::unique_ptr<Statement> &slot) {
+    while (slot && (slot->kind == NodeType::IfStatement || slot->kind == NodeType::UnlessStatement)) {
+        Expression *condition;
+        std::unique_ptr<Statement> *consequent;
+        std::unique_ptr<Statement> *alternate;
+        if (slot->kind == NodeType::IfStatement) {
+            auto ifStatement = static_cast<IfStatement *>(slot.get());
+            condition = ifStatement->condition.get();
+            consequent = &ifStatement->consequent;
+            alternate = &ifStatement->alternate;
+        } else {
+            auto unless = static_cast<UnlessStatement *>(slot.get());
+            condition = unless->condition.get();
+            consequent = &unless->consequent;
+            alternate = &unless->alternate;
+        }
+        if (condition->kind != NodeType::BooleanLiteral) {
+            break;
+        }
+
+        bool taken = static_cast<BooleanLiteral *>(condition)->value == (slot->kind == NodeType::IfStatement);
+        std::unique_ptr<Statement> branch = std::move(taken ? *consequent : *alternate);
+        slot = branch ? std::move(branch) : std::make_unique<EmptyStatement>();
+        prunedBranches++;
+    }
+    if (slot) {
+        prune(slot.get());
+    }
+}
+
+void ConstantFolding::pruneList(std::vector<std::unique_ptr<Statement>> &body) {
+    bool unreachable = false;
+    std::vector<std::unique_ptr<Statement>> reachable;
+    for (auto &statement: body) {
+        pruneSlot(statement);
+        // Declarations may be used before they appear, so they survive even when unreachable
+        if (unreachable && statement->kind != NodeType::FunctionDeclaration && statement->kind != NodeType::ModelDefinition) {
+            continue;
+        }
+        if (statement->kind == NodeType::ReturnStatement || statement->kind == NodeType::BreakStatement) {
+            unreachable = true;
+        }
+        reachable.emplace_back(std::move(statement));
+    }
+    body = std::move(reachable);
+}
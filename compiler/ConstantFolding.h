@@ -0,0 +1,43 @@
+#ifndef BOSSCRIPT_CONSTANTFOLDING_H
+#define BOSSCRIPT_CONSTANTFOLDING_H
+
+#include "Pass.h"
+
+// Folds arithmetic, comparison and logical expressions over literals, prunes ako/osim ako branches
+// with constant conditions and drops statements that follow vrati or prekid in the same block.
+// Only expressions whose result is certain are folded: division by zero and operations whose result
+// is not a finite number are left for the runtime.
+class ConstantFolding : public Pass {
+private:
+    size_t removedNodes = 0;
+    size_t foldedExpressions = 0;
+    size_t prunedBranches = 0;
+
+    void fold(std::unique_ptr<Expression> &expression);
+
+    std::unique_ptr<Expression> foldBinary(BinaryExpression *binary);
+
+    std::unique_ptr<Expression> foldLogical(LogicalExpression *logical);
+
+    std::unique_ptr<Expression> foldUnary(UnaryExpression *unary);
+
+    void prune(Statement *node);
+
+    void pruneList(std::vector<std::unique_ptr<Statement>> &body);
+
+    void pruneSlot(std::unique_ptr<Statement> &slot);
+
+    static size_t countNodes(Statement *node);
+
+public:
+    std::string name() const override {
+        return "constant-folding";
+    }
+
+    void run(Program &program) override;
+
+    void printStatistics(std::ostream &os) const override;
+};
+
+
+#endif //BOSSCRIPT_CONSTANTFOLDING_H
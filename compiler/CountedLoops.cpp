@@ -0,0 +1,67 @@
+#include "CountedLoops.h"
+#include "Bindings.h"
+#include "../parser/AST/ASTWalker.h"
+
+void CountedLoops::run(Program &program) {
+    assignedNames = Bindings::assignedNames(&program);
+    ASTWalker::walk(&program, [this](Statement *statement) {
+        if (statement->kind == NodeType::ForStatement) {
+            analyze(static_cast<ForStatement *>(statement));
+        }
+        return true;
+    });
+}
+
+void CountedLoops::printStatistics(std::ostream &os) const {
+    os << "Counted loops: " << counted << " of " << loops << std::endl;
+}
+
+void CountedLoops::analyze(ForStatement *loop) {
+    loops++;
+
+    auto boundInBody = Bindings::boundNames(loop->body.get());
+    if (boundInBody.count(loop->counter->symbol)) {
+        return;
+    }
+    // za svako (i od 0 do i + 5): the bound reads a different i than the counter, and a counted loop
+    // would read the counter instead
+    boundInBody.insert(loop->counter->symbol);
+
+    bool bodyHasCalls = false;
+    ASTWalker::walk(loop->body.get(), [&bodyHasCalls](Statement *statement) {
+        bodyHasCalls = bodyHasCalls || statement->kind == NodeType::CallExpression;
+        return !bodyHasCalls;
+    });
+
+    for (auto bound: {loop->startValue.get(), loop->endValue.get(), loop->step.get()}) {
+        if (bound && !isLoopInvariant(bound, boundInBody, bodyHasCalls)) {
+            return;
+        }
+    }
+
+    // prekid only leaves the loop, so the body is kept as is and break semantics are unchanged
+    loop->isCounted = true;
+    counted++;
+}
+
+bool CountedLoops::isLoopInvariant(Expression *expression, const std::set<std::string> &boundInBody, bool bodyHasCalls) const {
+    switch (expression->kind) {
+        case NodeType::NumericLiteral:
+            return true;
+        case NodeType::Identifier: {
+            const std::string &name = static_cast<Identifier *>(expression)->symbol;
+            return !boundInBody.count(name) && (!bodyHasCalls || !assignedNames.count(name));
+        }
+        case NodeType::UnaryExpression: {
+            auto unary = static_cast<UnaryExpression *>(expression);
+            return (unary->mOperator == "-" || unary->mOperator == "+") && isLoopInvariant(unary->operand.get(), boundInBody, bodyHasCalls);
+        }
+        case NodeType::BinaryExpression: {
+            auto binary = static_cast<BinaryExpression *>(expression);
+            return isLoopInvariant(binary->left.get(), boundInBody, bodyHasCalls)
+                   && isLoopInvariant(binary->right.get(), boundInBody, bodyHasCalls);
+        }
+        default:
+            return false;
+    }
+}
@@ -0,0 +1,32 @@
+#ifndef BOSSCRIPT_COUNTEDLOOPS_H
+#define BOSSCRIPT_COUNTEDLOOPS_H
+
+#include <set>
+#include "Pass.h"
+
+// Marks 'za svako' loops that can run as counted loops: start, end and step are evaluated once before the
+// first iteration and the counter is only advanced by the loop itself, so it can be kept unboxed and the
+// increment, compare and branch fused into one step. Whether the bounds are numbers is checked once on loop entry.
+class CountedLoops : public Pass {
+private:
+    // Names assigned anywhere in the program, these can change behind a call in the loop body
+    std::set<std::string> assignedNames;
+    size_t loops = 0;
+    size_t counted = 0;
+
+    bool isLoopInvariant(Expression *expression, const std::set<std::string> &boundInBody, bool bodyHasCalls) const;
+
+    void analyze(ForStatement *loop);
+
+public:
+    std::string name() const override {
+        return "counted-loops";
+    }
+
+    void run(Program &program) override;
+
+    void printStatistics(std::ostream &os) const override;
+};
+
+
+#endif //BOSSCRIPT_COUNTEDLOOPS_H
@@ -0,0 +1,250 @@
+#include "ElementKinds.h"
+#include "Bindings.h"
+#include "NumericValue.h"
+#include "../parser/AST/ASTWalker.h"
+
+void ElementKinds::run(Program &program) {
+    ASTWalker::walk(&program, [](Statement *statement) {
+        if (statement->kind == NodeType::ArrayLiteral) {
+            auto array = static_cast<ArrayLiteral *>(statement);
+            ElementKind kind = ElementKind::SmallInt;
+            for (const auto &element: array->arr) {
+                kind = join(kind, kindOf(element.get(), {}, {}));
+            }
+            array->elementKind = kind;
+        }
+        return true;
+    });
+
+    ASTWalker::walk(&program, [this](Statement *statement) {
+        if (statement->kind == NodeType::FunctionDeclaration) {
+            auto declaration = static_cast<FunctionDeclaration *>(statement);
+            analyzeFunction(declaration->body.get(), declaration->params);
+        }
+        else if (statement->kind == NodeType::FunctionExpression) {
+            auto expression = static_cast<FunctionExpression *>(statement);
+            analyzeFunction(expression->body.get(), expression->params);
+        }
+        return true;
+    });
+    analyzeFunction(&program, {});
+
+    ASTWalker::walk(&program, [this](Statement *statement) {
+        if (statement->kind == NodeType::ArrayLiteral) {
+            kindCounts[static_cast<size_t>(*static_cast<ArrayLiteral *>(statement)->elementKind)]++;
+        }
+        return true;
+    });
+}
+
+void ElementKinds::printStatistics(std::ostream &os) const {
+    os << "Element kinds: " << kindCounts[0] << " small int, " << kindCounts[1] << " double, " << kindCounts[2]
+       << " generic arrays, " << markedAccesses << " accesses without kind checks" << std::endl;
+}
+
+ElementKind ElementKinds::join(ElementKind a, ElementKind b) {
+    return std::max(a, b);
+}
+
+ElementKind ElementKinds::kindOf(Expression *expression, const std::map<std::string, ElementKind> &arrays,
+                                 const std::set<std::string> &integerCounters) {
+    switch (expression->kind) {
+        case NodeType::NumericLiteral:
+            return NumericValue::of(static_cast<NumericLiteral *>(expression)->value).isInteger() ? ElementKind::SmallInt : ElementKind::Double;
+        case NodeType::Identifier:
+            return integerCounters.count(static_cast<Identifier *>(expression)->symbol) ? ElementKind::SmallInt : ElementKind::Generic;
+        case NodeType::UnaryExpression: {
+            auto unary = static_cast<UnaryExpression *>(expression);
+            if (unary->mOperator != "-" && unary->mOperator != "+") {
+                return ElementKind::Generic;
+            }
+            // -0 is not a small integer
+            return join(ElementKind::Double, kindOf(unary->operand.get(), arrays, integerCounters));
+        }
+        case NodeType::BinaryExpression: {
+            // Integer arithmetic can overflow, so the result is only known to be a number
+            auto binary = static_cast<BinaryExpression *>(expression);
+            static const std::set<std::string> arithmetic = {"+", "-", "*", "/", "%", "^"};
+            if (!arithmetic.count(binary->mOperator)) {
+                return ElementKind::Generic;
+            }
+            return join(ElementKind::Double, join(kindOf(binary->left.get(), arrays, integerCounters),
+                                                  kindOf(binary->right.get(), arrays, integerCounters)));
+        }
+        case NodeType::MemberExpression: {
+            auto member = static_cast<MemberExpression *>(expression);
+            if (!member->isComputed || member->targetObject->kind != NodeType::Identifier) {
+                return ElementKind::Generic;
+            }
+            auto array = arrays.find(static_cast<Identifier *>(member->targetObject.get())->symbol);
+            return array == arrays.end() ? ElementKind::Generic : array->second;
+        }
+        default:
+            return ElementKind::Generic;
+    }
+}
+
+void ElementKinds::analyzeFunction(Statement *body, const std::vector<std::unique_ptr<FunctionParameter>> &params) {
+    std::map<std::string, ArrayLiteral *> literals;
+    std::set<std::string> rejected = Bindings::escapingNames(body);
+    std::vector<Store> stores;
+    std::vector<MemberExpression *> accesses;
+    std::vector<ForEachStatement *> loops;
+
+    for (const auto &param: params) {
+        rejected.insert(param->identifier->symbol);
+    }
+
+    auto isNestedFunction = [](Statement *statement) {
+        return statement->kind == NodeType::FunctionDeclaration || statement->kind == NodeType::FunctionExpression
+               || statement->kind == NodeType::ModelDefinition;
+    };
+
+    auto arrayAccess = [](Expression *expression) -> MemberExpression * {
+        auto member = dynamic_cast<MemberExpression *>(expression);
+        if (!member || member->targetObject->kind != NodeType::Identifier) {
+            return nullptr;
+        }
+        return member;
+    };
+    auto arrayName = [](MemberExpression *member) -> const std::string & {
+        return static_cast<Identifier *>(member->targetObject.get())->symbol;
+    };
+
+    // Integer counters in scope are tracked like in SmallIntegers, a store of the counter keeps small ints packed
+    std::function<void(Statement *, std::set<std::string> &)> collect = [&](Statement *node, std::set<std::string> &counters) {
+        if (isNestedFunction(node)) {
+            return;
+        }
+        switch (node->kind) {
+            case NodeType::ForStatement: {
+                // The bounds and the step are evaluated before the counter exists
+                auto loop = static_cast<ForStatement *>(node);
+                for (auto bound: {loop->startValue.get(), loop->endValue.get(), loop->step.get()}) {
+                    if (bound) collect(bound, counters);
+                }
+                const std::string &counter = loop->counter->symbol;
+                bool outer = counters.count(counter);
+                if (loop->hasIntegerCounter) {
+                    counters.insert(counter);
+                } else {
+                    counters.erase(counter);
+                }
+                collect(loop->body.get(), counters);
+                if (outer) {
+                    counters.insert(counter);
+                } else {
+                    counters.erase(counter);
+                }
+                return;
+            }
+            case NodeType::ForEachStatement: {
+                // The element hides an outer counter with the same name
+                auto loop = static_cast<ForEachStatement *>(node);
+                loops.push_back(loop);
+                collect(loop->iterable.get(), counters);
+                bool outer = counters.erase(loop->element->symbol);
+                collect(loop->body.get(), counters);
+                if (outer) {
+                    counters.insert(loop->element->symbol);
+                }
+                return;
+            }
+            case NodeType::VariableDeclaration: {
+                auto declaration = static_cast<VariableDeclaration *>(node);
+                if (literals.count(declaration->name)) {
+                    rejected.insert(declaration->name);
+                }
+                if (declaration->value && declaration->value->kind == NodeType::ArrayLiteral) {
+                    literals.emplace(declaration->name, static_cast<ArrayLiteral *>(declaration->value.get()));
+                }
+                break;
+            }
+            case NodeType::AssignmentExpression: {
+                auto assignment = static_cast<AssignmentExpression *>(node);
+                if (auto member = arrayAccess(assignment->assignee.get())) {
+                    if (!member->isComputed) {
+                        rejected.insert(arrayName(member));
+                    }
+                    stores.push_back(Store{arrayName(member), assignment->value.get(), assignment->assignmentOperator != "=", counters});
+                }
+                break;
+            }
+            case NodeType::UnaryExpression: {
+                auto unary = static_cast<UnaryExpression *>(node);
+                auto member = arrayAccess(unary->operand.get());
+                if (member && (unary->mOperator == "++" || unary->mOperator == "--")) {
+                    if (!member->isComputed) {
+                        rejected.insert(arrayName(member));
+                    }
+                    stores.push_back(Store{arrayName(member), nullptr, true, counters});
+                }
+                break;
+            }
+            case NodeType::MemberExpression: {
+                auto member = arrayAccess(static_cast<MemberExpression *>(node));
+                if (member && member->isComputed) {
+                    accesses.push_back(member);
+                }
+                break;
+            }
+            default:
+                break;
+        }
+        ASTWalker::forEachChild(node, [&collect, &counters](Statement *child) {
+            collect(child, counters);
+        });
+    };
+    std::set<std::string> counters;
+    ASTWalker::forEachChild(body, [&collect, &counters](Statement *child) {
+        collect(child, counters);
+    });
+
+    std::map<std::string, ElementKind> kinds;
+    for (const auto &[name, literal]: literals) {
+        if (!rejected.count(name)) {
+            kinds[name] = *literal->elementKind;
+        }
+    }
+
+    // Loads from one array can feed stores into another, so iterate until no kind changes
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (const auto &store: stores) {
+            auto array = kinds.find(store.array);
+            if (array == kinds.end()) {
+                continue;
+            }
+            ElementKind stored = store.value ? kindOf(store.value, kinds, store.integerCounters) : ElementKind::Double;
+            if (store.isArithmetic) {
+                stored = join(ElementKind::Double, join(stored, array->second));
+            }
+            if (join(array->second, stored) != array->second) {
+                array->second = join(array->second, stored);
+                changed = true;
+            }
+        }
+    }
+
+    for (const auto &[name, kind]: kinds) {
+        literals[name]->elementKind = kind;
+    }
+    for (auto member: accesses) {
+        auto array = kinds.find(arrayName(member));
+        if (array != kinds.end() && array->second != ElementKind::Generic) {
+            member->elementKind = array->second;
+            markedAccesses++;
+        }
+    }
+    for (auto loop: loops) {
+        if (loop->iterable->kind == NodeType::ArrayLiteral) {
+            loop->elementKind = static_cast<ArrayLiteral *>(loop->iterable.get())->elementKind;
+        } else if (loop->iterable->kind == NodeType::Identifier) {
+            auto array = kinds.find(static_cast<Identifier *>(loop->iterable.get())->symbol);
+            if (array != kinds.end()) {
+                loop->elementKind = array->second;
+            }
+        }
+    }
+}
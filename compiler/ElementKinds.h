@@ -0,0 +1,46 @@
+#ifndef BOSSCRIPT_ELEMENTKINDS_H
+#define BOSSCRIPT_ELEMENTKINDS_H
+
+#include <map>
+#include <set>
+#include "Pass.h"
+
+// Infers the element kind of arrays: packed small integers, packed doubles or generic values.
+// Every array literal gets the kind of its elements. An array held by a local variable that never escapes
+// (see Bindings::escapingNames) only changes through indexed stores in its function, so its kind is the
+// join of the literal and every stored value. The literal is then allocated with that kind up front and
+// indexed accesses on the variable are marked, so they need neither a kind check nor a transition.
+// For-each loops over a literal or such a variable are marked with the kind of the elements they bind.
+class ElementKinds : public Pass {
+private:
+    class Store {
+    public:
+        std::string array;
+        Expression *value;
+        // Compound assignments and ++/-- store the result of arithmetic on the old element
+        bool isArithmetic;
+        std::set<std::string> integerCounters;
+    };
+
+    size_t kindCounts[3] = {0, 0, 0};
+    size_t markedAccesses = 0;
+
+    static ElementKind join(ElementKind a, ElementKind b);
+
+    static ElementKind kindOf(Expression *expression, const std::map<std::string, ElementKind> &arrays,
+                              const std::set<std::string> &integerCounters);
+
+    void analyzeFunction(Statement *body, const std::vector<std::unique_ptr<FunctionParameter>> &params);
+
+public:
+    std::string name() const override {
+        return "element-kinds";
+    }
+
+    void run(Program &program) override;
+
+    void printStatistics(std::ostream &os) const override;
+};
+
+
+#endif //BOSSCRIPT_ELEMENTKINDS_H
@@ -0,0 +1,64 @@
+#ifndef BOSSCRIPT_EXECUTIONBUDGET_H
+#define BOSSCRIPT_EXECUTIONBUDGET_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+
+// Budget of one script invocation, charged at the checks placed by the safepoints pass. The check is a
+// subtraction, a relaxed load and a branch. When the current slice runs out, or another thread interrupts
+// the invocation, the embedder's hook decides what happens: run another slice, suspend the invocation so
+// it can be resumed later, or cancel it.
+class ExecutionBudget {
+public:
+    enum class Decision {
+        Continue,
+        Suspend,
+        Cancel
+    };
+
+    using Hook = std::function<Decision(ExecutionBudget &)>;
+
+private:
+    int64_t slice;
+    int64_t remaining;
+    uint64_t charged = 0;
+    std::atomic<bool> interrupted{false};
+    Hook hook;
+
+    Decision exhausted() {
+        interrupted.store(false, std::memory_order_relaxed);
+        auto decision = hook ? hook(*this) : Decision::Continue;
+        if (decision != Decision::Cancel) {
+            // A resumed invocation starts with a full slice
+            charged += static_cast<uint64_t>(slice - remaining);
+            remaining = slice;
+        }
+        return decision;
+    }
+
+public:
+    explicit ExecutionBudget(int64_t slice, Hook hook = nullptr) : slice(slice), remaining(slice), hook(std::move(hook)) {}
+
+    // Called by the invocation's own thread at every safepoint
+    Decision charge(size_t cost) {
+        remaining -= static_cast<int64_t>(cost);
+        if (remaining > 0 && !interrupted.load(std::memory_order_relaxed)) {
+            return Decision::Continue;
+        }
+        return exhausted();
+    }
+
+    // Can be called from any thread, the invocation calls the hook at its next safepoint
+    void interrupt() {
+        interrupted.store(true, std::memory_order_relaxed);
+    }
+
+    // Total cost of the slices used so far, for CPU quotas
+    uint64_t used() const {
+        return charged + static_cast<uint64_t>(slice - remaining);
+    }
+};
+
+
+#endif //BOSSCRIPT_EXECUTIONBUDGET_H
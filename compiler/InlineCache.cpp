@@ -0,0 +1,59 @@
+#include "InlineCache.h"
+#include <functional>
+
+size_t GlobalLookupCache::lineOf(size_t shape, const std::string &property) {
+    return (std::hash<std::string>()(property) ^ (shape * 0x9E3779B97F4A7C15ull)) % lines;
+}
+
+std::optional<size_t> GlobalLookupCache::lookup(size_t shape, const std::string &property) {
+    const Line &line = cache[lineOf(shape, property)];
+    if (line.valid && line.shape == shape && line.property == property) {
+        return line.index;
+    }
+    return std::nullopt;
+}
+
+void GlobalLookupCache::insert(size_t shape, const std::string &property, size_t index) {
+    Line &line = cache[lineOf(shape, property)];
+    line.valid = true;
+    line.shape = shape;
+    line.property = property;
+    line.index = index;
+}
+
+std::optional<size_t> InlineCache::lookup(size_t shape, GlobalLookupCache &global) {
+    if (state == CacheState::Megamorphic) {
+        return global.lookup(shape, property);
+    }
+    for (const auto &entry: entries) {
+        if (entry.shape == shape) {
+            return entry.index;
+        }
+    }
+    return std::nullopt;
+}
+
+void InlineCache::update(size_t shape, size_t index, GlobalLookupCache &global) {
+    if (state == CacheState::Megamorphic) {
+        global.insert(shape, property, index);
+        return;
+    }
+    for (auto &entry: entries) {
+        if (entry.shape == shape) {
+            entry.index = index;
+            return;
+        }
+    }
+    if (entries.size() == maxEntries) {
+        // Too many receiver shapes, the site falls back to the global cache for good
+        for (const auto &entry: entries) {
+            global.insert(entry.shape, property, entry.index);
+        }
+        global.insert(shape, property, index);
+        entries.clear();
+        state = CacheState::Megamorphic;
+        return;
+    }
+    entries.emplace_back(shape, index);
+    state = entries.size() == 1 ? CacheState::Monomorphic : CacheState::Polymorphic;
+}
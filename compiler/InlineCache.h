@@ -0,0 +1,87 @@
+#ifndef BOSSCRIPT_INLINECACHE_H
+#define BOSSCRIPT_INLINECACHE_H
+
+#include <array>
+#include <string>
+#include <vector>
+#include <optional>
+
+enum class CacheSiteKind {
+    Load,
+    Store,
+    Call
+};
+
+enum class CacheState {
+    Uninitialized,
+    Monomorphic,
+    Polymorphic,
+    Megamorphic
+};
+
+// For model shapes at call sites index is the method table index, otherwise it is the property slot
+class CacheEntry {
+public:
+    size_t shape;
+    size_t index;
+
+    CacheEntry(size_t shape, size_t index) : shape(shape), index(index) {}
+};
+
+// Direct-mapped (shape, property) -> index cache shared by all megamorphic sites
+class GlobalLookupCache {
+private:
+    class Line {
+    public:
+        bool valid = false;
+        size_t shape = 0;
+        std::string property;
+        size_t index = 0;
+    };
+
+    static constexpr size_t lines = 1024;
+    std::array<Line, lines> cache;
+
+    static size_t lineOf(size_t shape, const std::string &property);
+
+public:
+    std::optional<size_t> lookup(size_t shape, const std::string &property);
+
+    void insert(size_t shape, const std::string &property, size_t index);
+};
+
+class InlineCache {
+public:
+    static constexpr size_t maxEntries = 4;
+
+    CacheSiteKind kind;
+    std::string property;
+    CacheState state = CacheState::Uninitialized;
+    std::vector<CacheEntry> entries;
+
+    InlineCache(CacheSiteKind kind, std::string property) : kind(kind), property(std::move(property)) {}
+
+    std::optional<size_t> lookup(size_t shape, GlobalLookupCache &global);
+
+    // Records the result of a full lookup after a miss
+    void update(size_t shape, size_t index, GlobalLookupCache &global);
+};
+
+// Inline caches of one execution of a program, indexed by the cacheSite of AST nodes. Caches change on every
+// miss, so an execution starts from a copy of the ones seeded at compile time and never shares it between threads.
+class InlineCaches {
+public:
+    std::vector<InlineCache> sites;
+    GlobalLookupCache global;
+
+    std::optional<size_t> lookup(size_t site, size_t shape) {
+        return sites[site].lookup(shape, global);
+    }
+
+    void update(size_t site, size_t shape, size_t index) {
+        sites[site].update(shape, index, global);
+    }
+};
+
+
+#endif //BOSSCRIPT_INLINECACHE_H
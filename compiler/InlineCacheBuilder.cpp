@@ -0,0 +1,171 @@
+#include "InlineCacheBuilder.h"
+#include "MethodTable.h"
+#include "../parser/AST/ASTWalker.h"
+
+void InlineCacheBuilder::run(Program &program) {
+    ASTWalker::walk(&program, [this](Statement *statement) {
+        if (statement->kind == NodeType::Object) {
+            auto object = static_cast<ObjectLiteral *>(statement);
+            size_t shape = ShapeTable::emptyShape;
+            for (const auto &property: object->properties) {
+                shape = shapes.transition(shape, property->key);
+            }
+            object->shape = shape;
+            dictionaryLiterals += shape == ShapeTable::dictionaryShape;
+        }
+        return true;
+    });
+
+    buildSites(&program, nullptr, {});
+}
+
+size_t InlineCacheBuilder::shapeOf(const ModelDefinitionStatement *model) {
+    size_t shape = shapes.shapeOfModel(*model->layout);
+    modelShapes[shape] = model;
+    return shape;
+}
+
+void InlineCacheBuilder::buildSites(Statement *node, const ModelDefinitionStatement *self, const ReceiverShapes &receivers) {
+    // Member expressions that are the target of a store or the callee of a call get the site of their parent
+    std::set<MemberExpression *> stores;
+    std::set<MemberExpression *> compoundStores;
+    std::set<MemberExpression *> callees;
+
+    ASTWalker::walk(node, [&](Statement *statement) {
+        switch (statement->kind) {
+            case NodeType::ModelDefinition: {
+                auto model = static_cast<ModelDefinitionStatement *>(statement);
+                ASTWalker::forEachChild(model, [&](Statement *member) {
+                    buildSites(member, model, receivers);
+                });
+                return false;
+            }
+            case NodeType::FunctionDeclaration: {
+                auto declaration = static_cast<FunctionDeclaration *>(statement);
+                buildFunction(declaration->params, declaration->body.get(), self, receivers);
+                return false;
+            }
+            case NodeType::FunctionExpression: {
+                auto expression = static_cast<FunctionExpression *>(statement);
+                buildFunction(expression->params, expression->body.get(), self, receivers);
+                return false;
+            }
+            case NodeType::AssignmentExpression: {
+                auto assignment = static_cast<AssignmentExpression *>(statement);
+                if (assignment->assignee->kind == NodeType::MemberExpression) {
+                    auto member = static_cast<MemberExpression *>(assignment->assignee.get());
+                    stores.insert(member);
+                    if (assignment->assignmentOperator != "=") {
+                        compoundStores.insert(member);
+                    }
+                }
+                return true;
+            }
+            case NodeType::CallExpression: {
+                auto call = static_cast<CallExpression *>(statement);
+                if (call->callee->kind == NodeType::MemberExpression && !static_cast<MemberExpression *>(call->callee.get())->isComputed) {
+                    auto callee = static_cast<MemberExpression *>(call->callee.get());
+                    callees.insert(callee);
+                    call->cacheSite = addSite(CacheSiteKind::Call, callee, self, receivers);
+                }
+                return true;
+            }
+            case NodeType::MemberExpression: {
+                auto member = static_cast<MemberExpression *>(statement);
+                if (!member->isComputed && !callees.count(member)) {
+                    if (compoundStores.count(member)) {
+                        member->loadSite = addSite(CacheSiteKind::Load, member, self, receivers);
+                    }
+                    member->cacheSite = addSite(stores.count(member) ? CacheSiteKind::Store : CacheSiteKind::Load, member, self, receivers);
+                }
+                return true;
+            }
+            default:
+                return true;
+        }
+    });
+}
+
+void InlineCacheBuilder::buildFunction(const std::vector<std::unique_ptr<FunctionParameter>> &params, BlockStatement *body,
+                                       const ModelDefinitionStatement *self, const ReceiverShapes &outer) {
+    ReceiverShapes receivers = outer;
+    for (const auto &param: params) {
+        const std::string &name = param->identifier->symbol;
+        receivers.erase(name);
+        if (param->typeAnnotation && !param->typeAnnotation->isArrayType) {
+            if (auto model = models.modelOf(param->typeAnnotation->typeName)) {
+                receivers[name].insert(shapeOf(model));
+            }
+        }
+    }
+
+    // Seeds are only hints, every cached entry is guarded by a shape check, so names are not tracked flow-sensitively
+    ASTWalker::walk(body, [&receivers](Statement *statement) {
+        std::string name;
+        Expression *value = nullptr;
+        if (statement->kind == NodeType::VariableDeclaration) {
+            name = static_cast<VariableDeclaration *>(statement)->name;
+            value = static_cast<VariableDeclaration *>(statement)->value.get();
+        }
+        else if (statement->kind == NodeType::AssignmentExpression) {
+            auto assignment = static_cast<AssignmentExpression *>(statement);
+            if (assignment->assignee->kind == NodeType::Identifier) {
+                name = static_cast<Identifier *>(assignment->assignee.get())->symbol;
+                value = assignment->value.get();
+            }
+        }
+        if (value && value->kind == NodeType::Object) {
+            receivers[name].insert(*static_cast<ObjectLiteral *>(value)->shape);
+        }
+        return statement->kind != NodeType::FunctionDeclaration && statement->kind != NodeType::FunctionExpression;
+    });
+
+    buildSites(body, self, receivers);
+}
+
+size_t InlineCacheBuilder::addSite(CacheSiteKind kind, MemberExpression *member, const ModelDefinitionStatement *self, const ReceiverShapes &receivers) {
+    const std::string &property = static_cast<Identifier *>(member->property.get())->symbol;
+    InlineCache cache(kind, property);
+
+    std::set<size_t> receiverShapes;
+    if (member->targetObject->kind == NodeType::Identifier) {
+        const std::string &target = static_cast<Identifier *>(member->targetObject.get())->symbol;
+        if (target == "@" && self) {
+            receiverShapes.insert(shapeOf(self));
+        }
+        else if (auto known = receivers.find(target); known != receivers.end()) {
+            receiverShapes = known->second;
+        }
+    }
+
+    for (size_t shape: receiverShapes) {
+        std::optional<size_t> index;
+        auto model = modelShapes.find(shape);
+        if (kind == CacheSiteKind::Call && model != modelShapes.end()) {
+            index = model->second->methodTable->indexOf(property);
+        }
+        else {
+            index = shapes.get(shape).slotOf(property);
+        }
+        if (index) {
+            cache.update(shape, *index, caches.global);
+        }
+    }
+
+    caches.sites.emplace_back(std::move(cache));
+    return caches.sites.size() - 1;
+}
+
+void InlineCacheBuilder::printStatistics(std::ostream &os) const {
+    std::map<CacheSiteKind, size_t> sites;
+    std::map<CacheState, size_t> states;
+    for (const auto &cache: caches.sites) {
+        sites[cache.kind]++;
+        states[cache.state]++;
+    }
+
+    os << "[IC] shapes: " << shapes.size() << ", dictionary-mode literals: " << dictionaryLiterals << ", sites: " << caches.sites.size()
+       << " (load " << sites[CacheSiteKind::Load] << ", store " << sites[CacheSiteKind::Store] << ", call " << sites[CacheSiteKind::Call] << ")" << std::endl;
+    os << "[IC] uninitialized " << states[CacheState::Uninitialized] << ", monomorphic " << states[CacheState::Monomorphic]
+       << ", polymorphic " << states[CacheState::Polymorphic] << ", megamorphic " << states[CacheState::Megamorphic] << std::endl;
+}
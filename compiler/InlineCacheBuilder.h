@@ -0,0 +1,52 @@
+#ifndef BOSSCRIPT_INLINECACHEBUILDER_H
+#define BOSSCRIPT_INLINECACHEBUILDER_H
+
+#include <map>
+#include <set>
+#include <ostream>
+#include "ShapeTable.h"
+#include "InlineCache.h"
+#include "ModelAnalyzer.h"
+#include "Pass.h"
+
+// Assigns a shape to every object literal and an inline cache to every non-computed property load,
+// property store and method call site. Caches are seeded with the receiver shapes that are known at
+// compile time: object literals bound to a name, @ inside a model and parameters typed with a model.
+class InlineCacheBuilder : public Pass {
+private:
+    using ReceiverShapes = std::map<std::string, std::set<size_t>>;
+
+    const ModelAnalyzer &models;
+    ShapeTable shapes;
+    InlineCaches caches;
+    std::map<size_t, const ModelDefinitionStatement *> modelShapes;
+    size_t dictionaryLiterals = 0;
+
+    size_t shapeOf(const ModelDefinitionStatement *model);
+
+    void buildSites(Statement *node, const ModelDefinitionStatement *self, const ReceiverShapes &receivers);
+
+    void buildFunction(const std::vector<std::unique_ptr<FunctionParameter>> &params, BlockStatement *body,
+                       const ModelDefinitionStatement *self, const ReceiverShapes &outer);
+
+    size_t addSite(CacheSiteKind kind, MemberExpression *member, const ModelDefinitionStatement *self, const ReceiverShapes &receivers);
+
+public:
+    explicit InlineCacheBuilder(const ModelAnalyzer &models) : models(models) {}
+
+    std::string name() const override {
+        return "inline-caches";
+    }
+
+    void run(Program &program) override;
+
+    void printStatistics(std::ostream &os) const override;
+
+    // Caches with the receiver shapes known at compile time, every execution starts from a copy
+    const InlineCaches &seeds() const {
+        return caches;
+    }
+};
+
+
+#endif //BOSSCRIPT_INLINECACHEBUILDER_H
@@ -0,0 +1,40 @@
+#include "MethodTable.h"
+
+MethodTable::MethodTable(std::string modelName, const MethodTable *parent) : modelName(std::move(modelName)) {
+    if (parent) {
+        methods = parent->methods;
+        indices = parent->indices;
+    }
+}
+
+void MethodTable::addMethod(FunctionDeclaration *declaration, bool isPrivate) {
+    const std::string &name = declaration->name->symbol;
+    auto existing = indices.find(name);
+
+    if (existing == indices.end()) {
+        indices[name] = methods.size();
+        methods.emplace_back(name, declaration, modelName, isPrivate);
+        return;
+    }
+
+    MethodEntry &entry = methods[existing->second];
+    if (entry.ownerModel == modelName) {
+        throw std::runtime_error("Metoda '" + name + "' je već definisana u modelu " + modelName);
+    }
+    if (entry.isPrivate) {
+        throw std::runtime_error("Model " + modelName + " ne može redefinisati privatnu metodu '" + name + "' modela " + entry.ownerModel);
+    }
+    if (isPrivate) {
+        throw std::runtime_error("Model " + modelName + " ne može redefinisati javnu metodu '" + name + "' kao privatnu");
+    }
+    entry.declaration = declaration;
+    entry.ownerModel = modelName;
+}
+
+std::optional<size_t> MethodTable::indexOf(const std::string &name) const {
+    auto index = indices.find(name);
+    if (index == indices.end()) {
+        return std::nullopt;
+    }
+    return index->second;
+}
@@ -0,0 +1,40 @@
+#ifndef BOSSCRIPT_METHODTABLE_H
+#define BOSSCRIPT_METHODTABLE_H
+
+#include <string>
+#include <vector>
+#include <optional>
+#include <unordered_map>
+#include "../parser/AST/Statements.h"
+
+class MethodEntry {
+public:
+    std::string name;
+    FunctionDeclaration *declaration;
+    std::string ownerModel;
+    bool isPrivate;
+
+    MethodEntry(std::string name, FunctionDeclaration *declaration, std::string ownerModel, bool isPrivate)
+            : name(std::move(name)), declaration(declaration), ownerModel(std::move(ownerModel)), isPrivate(isPrivate) {}
+};
+
+// Flattened method table of a model, shared by all of its instances.
+// Inherited methods keep the parent's indices and overrides replace the entry in place, so an index
+// resolved against a parent model dispatches correctly on every model derived from it.
+class MethodTable {
+private:
+    std::unordered_map<std::string, size_t> indices;
+
+public:
+    std::string modelName;
+    std::vector<MethodEntry> methods;
+
+    MethodTable(std::string modelName, const MethodTable *parent);
+
+    void addMethod(FunctionDeclaration *declaration, bool isPrivate);
+
+    std::optional<size_t> indexOf(const std::string &name) const;
+};
+
+
+#endif //BOSSCRIPT_METHODTABLE_H
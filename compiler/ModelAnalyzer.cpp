@@ -0,0 +1,150 @@
+#include "ModelAnalyzer.h"
+#include "Bindings.h"
+#include "../parser/AST/ASTWalker.h"
+
+void ModelAnalyzer::run(Program &program) {
+    ASTWalker::walk(&program, [this](Statement *statement) {
+        if (statement->kind != NodeType::ModelDefinition) {
+            return true;
+        }
+        auto model = static_cast<ModelDefinitionStatement *>(statement);
+        if (!models.emplace(model->className->symbol, model).second) {
+            throw std::runtime_error("Model " + model->className->symbol + " je već definisan");
+        }
+        return false;
+    });
+
+    for (const auto &[name, model]: models) {
+        std::set<std::string> inProgress;
+        buildModel(model, inProgress);
+    }
+
+    resolveMembers(&program, nullptr, {});
+}
+
+const ModelDefinitionStatement *ModelAnalyzer::modelOf(const std::string &modelName) const {
+    auto model = models.find(modelName);
+    return model == models.end() ? nullptr : model->second;
+}
+
+void ModelAnalyzer::buildModel(ModelDefinitionStatement *model, std::set<std::string> &inProgress) {
+    const std::string &name = model->className->symbol;
+    if (model->layout) {
+        return;
+    }
+    if (!inProgress.insert(name).second) {
+        throw std::runtime_error("Model " + name + " nasljeđuje sam sebe");
+    }
+
+    ModelDefinitionStatement *parent = nullptr;
+    if (model->parentClassName) {
+        auto parentModel = models.find(model->parentClassName->symbol);
+        if (parentModel == models.end()) {
+            throw std::runtime_error("Model " + name + " nasljeđuje nepoznat model " + model->parentClassName->symbol);
+        }
+        parent = parentModel->second;
+        buildModel(parent, inProgress);
+    }
+
+    auto layout = std::make_shared<ModelLayout>(name, parent ? parent->layout : nullptr);
+    auto methodTable = std::make_shared<MethodTable>(name, parent ? parent->methodTable.get() : nullptr);
+
+    for (auto block: {model->privateBlock.get(), model->publicBlock.get()}) {
+        if (!block) continue;
+        for (const auto &member: block->getBody()) {
+            if (member->kind == NodeType::VariableStatement) {
+                for (const auto &declaration: static_cast<VariableStatement *>(member.get())->declarations) {
+                    layout->addField(declaration->name);
+                }
+            }
+            else if (member->kind == NodeType::FunctionDeclaration) {
+                methodTable->addMethod(static_cast<FunctionDeclaration *>(member.get()), block == model->privateBlock.get());
+            }
+        }
+    }
+
+    for (const auto &method: methodTable->methods) {
+        if (layout->slotOf(method.name)) {
+            throw std::runtime_error("Model " + name + " ima polje i metodu sa istim imenom '" + method.name + "'");
+        }
+    }
+
+    model->layout = layout;
+    model->methodTable = methodTable;
+}
+
+void ModelAnalyzer::resolveMembers(Statement *node, const ModelDefinitionStatement *self, const TypedNames &typed) {
+    ASTWalker::walk(node, [&](Statement *statement) {
+        switch (statement->kind) {
+            case NodeType::ModelDefinition: {
+                auto model = static_cast<ModelDefinitionStatement *>(statement);
+                ASTWalker::forEachChild(model, [&](Statement *member) {
+                    resolveMembers(member, model, typed);
+                });
+                return false;
+            }
+            case NodeType::FunctionDeclaration: {
+                auto declaration = static_cast<FunctionDeclaration *>(statement);
+                resolveFunction(declaration->params, declaration->body.get(), self, typed);
+                return false;
+            }
+            case NodeType::FunctionExpression: {
+                auto expression = static_cast<FunctionExpression *>(statement);
+                resolveFunction(expression->params, expression->body.get(), self, typed);
+                return false;
+            }
+            case NodeType::MemberExpression: {
+                auto member = static_cast<MemberExpression *>(statement);
+                if (member->isComputed || member->targetObject->kind != NodeType::Identifier) {
+                    return true;
+                }
+                const std::string &target = static_cast<Identifier *>(member->targetObject.get())->symbol;
+                if (target == "@") {
+                    if (self) resolveMember(member, self, self);
+                } else if (auto typedName = typed.find(target); typedName != typed.end()) {
+                    resolveMember(member, typedName->second, self);
+                }
+                return true;
+            }
+            default:
+                return true;
+        }
+    });
+}
+
+void ModelAnalyzer::resolveMember(MemberExpression *member, const ModelDefinitionStatement *target, const ModelDefinitionStatement *self) {
+    const std::string &property = static_cast<Identifier *>(member->property.get())->symbol;
+    member->slot = target->layout->slotOf(property);
+    member->methodIndex = target->methodTable->indexOf(property);
+
+    if (member->methodIndex) {
+        const MethodEntry &method = target->methodTable->methods[*member->methodIndex];
+        if (method.isPrivate && (!self || self->className->symbol != method.ownerModel)) {
+            throw std::runtime_error("Metoda '" + property + "' je privatna u modelu " + method.ownerModel);
+        }
+    }
+}
+
+void ModelAnalyzer::resolveFunction(const std::vector<std::unique_ptr<FunctionParameter>> &params, BlockStatement *body,
+                                    const ModelDefinitionStatement *self, const TypedNames &typed) {
+    // Only names that are never reassigned or shadowed can be trusted to hold an instance of their model
+    auto rebound = Bindings::boundNames(body);
+    TypedNames scope;
+    for (const auto &[name, model]: typed) {
+        if (!rebound.count(name)) {
+            scope[name] = model;
+        }
+    }
+
+    for (const auto &param: params) {
+        const std::string &name = param->identifier->symbol;
+        scope.erase(name);
+        if (param->typeAnnotation && !param->typeAnnotation->isArrayType && !rebound.count(name)) {
+            if (auto model = modelOf(param->typeAnnotation->typeName)) {
+                scope[name] = model;
+            }
+        }
+    }
+
+    resolveMembers(body, self, scope);
+}
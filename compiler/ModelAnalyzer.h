@@ -0,0 +1,41 @@
+#ifndef BOSSCRIPT_MODELANALYZER_H
+#define BOSSCRIPT_MODELANALYZER_H
+
+#include <map>
+#include <set>
+#include <memory>
+#include "ModelLayout.h"
+#include "MethodTable.h"
+#include "Pass.h"
+#include "../parser/AST/Statements.h"
+
+// Computes the slot layout and method table of every model in a program, then resolves member accesses
+// (@x, drugi.x, @manjeOd, drugi.plus) whose target model is known at compile time to slot and method indices
+class ModelAnalyzer : public Pass {
+private:
+    // Names bound to an instance of a known model in the current function, e.g. typed parameters
+    using TypedNames = std::map<std::string, const ModelDefinitionStatement *>;
+
+    std::map<std::string, ModelDefinitionStatement *> models;
+
+    void buildModel(ModelDefinitionStatement *model, std::set<std::string> &inProgress);
+
+    void resolveMembers(Statement *node, const ModelDefinitionStatement *self, const TypedNames &typed);
+
+    void resolveFunction(const std::vector<std::unique_ptr<FunctionParameter>> &params, BlockStatement *body,
+                         const ModelDefinitionStatement *self, const TypedNames &typed);
+
+    static void resolveMember(MemberExpression *member, const ModelDefinitionStatement *target, const ModelDefinitionStatement *self);
+
+public:
+    std::string name() const override {
+        return "models";
+    }
+
+    void run(Program &program) override;
+
+    const ModelDefinitionStatement *modelOf(const std::string &modelName) const;
+};
+
+
+#endif //BOSSCRIPT_MODELANALYZER_H
@@ -0,0 +1,31 @@
+#include "ModelLayout.h"
+#include <stdexcept>
+
+ModelLayout::ModelLayout(std::string modelName, std::shared_ptr<ModelLayout> parent)
+        : modelName(std::move(modelName)), parent(std::move(parent)) {
+    if (this->parent) {
+        fields = this->parent->fields;
+        slots = this->parent->slots;
+    }
+}
+
+void ModelLayout::addField(const std::string &name) {
+    auto existing = slots.find(name);
+    if (existing != slots.end()) {
+        if (parent && existing->second < parent->size()) {
+            // Redeclared inherited field, the instance keeps a single slot for it
+            return;
+        }
+        throw std::runtime_error("Polje '" + name + "' je već deklarisano u modelu " + modelName);
+    }
+    slots[name] = fields.size();
+    fields.push_back(name);
+}
+
+std::optional<size_t> ModelLayout::slotOf(const std::string &name) const {
+    auto slot = slots.find(name);
+    if (slot == slots.end()) {
+        return std::nullopt;
+    }
+    return slot->second;
+}
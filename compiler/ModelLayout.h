@@ -0,0 +1,33 @@
+#ifndef BOSSCRIPT_MODELLAYOUT_H
+#define BOSSCRIPT_MODELLAYOUT_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+
+// Fixed slot layout of a model instance. Inherited fields keep the parent's offsets and come first,
+// so a slot resolved against a parent model is valid for every model derived from it.
+class ModelLayout {
+private:
+    std::unordered_map<std::string, size_t> slots;
+
+public:
+    std::string modelName;
+    std::shared_ptr<ModelLayout> parent;
+    std::vector<std::string> fields;
+
+    ModelLayout(std::string modelName, std::shared_ptr<ModelLayout> parent);
+
+    void addField(const std::string &name);
+
+    std::optional<size_t> slotOf(const std::string &name) const;
+
+    size_t size() const {
+        return fields.size();
+    }
+};
+
+
+#endif //BOSSCRIPT_MODELLAYOUT_H
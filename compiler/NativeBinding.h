@@ -0,0 +1,119 @@
+#ifndef BOSSCRIPT_NATIVEBINDING_H
+#define BOSSCRIPT_NATIVEBINDING_H
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include "Value.h"
+
+// Calling convention for native functions: arguments are read straight from the caller's value slots
+using NativeFunction = Value (*)(const Value *args, size_t count);
+
+template<typename T>
+struct NativeArgument;
+
+template<>
+struct NativeArgument<double> {
+    static double convert(Value value) {
+        if (!value.isNumber()) {
+            throw std::runtime_error("Argument mora biti broj");
+        }
+        return value.asNumber();
+    }
+};
+
+// Integral doubles in range are always stored as small integers, so anything else is not an int32
+template<>
+struct NativeArgument<int32_t> {
+    static int32_t convert(Value value) {
+        if (!value.isInteger()) {
+            throw std::runtime_error("Argument mora biti cijeli broj");
+        }
+        return value.asInteger();
+    }
+};
+
+template<>
+struct NativeArgument<bool> {
+    static bool convert(Value value) {
+        if (!value.isBoolean()) {
+            throw std::runtime_error("Argument mora biti logička vrijednost");
+        }
+        return value.asBoolean();
+    }
+};
+
+template<>
+struct NativeArgument<std::string_view> {
+    static std::string_view convert(Value value) {
+        if (!value.isString()) {
+            throw std::runtime_error("Argument mora biti string");
+        }
+        return *value.asString();
+    }
+};
+
+template<typename T>
+struct NativeResult;
+
+template<>
+struct NativeResult<double> {
+    static Value convert(double value) {
+        return Value::number(value);
+    }
+};
+
+template<>
+struct NativeResult<int32_t> {
+    static Value convert(int32_t value) {
+        return Value::integer(value);
+    }
+};
+
+template<>
+struct NativeResult<bool> {
+    static Value convert(bool value) {
+        return Value::boolean(value);
+    }
+};
+
+template<typename Signature>
+struct NativeSignature;
+
+template<typename R, typename... Args>
+struct NativeSignature<R (*)(Args...)> {
+    static constexpr size_t arity = sizeof...(Args);
+
+    template<auto function, size_t... I>
+    static Value call(const Value *args, std::index_sequence<I...>) {
+        if constexpr (std::is_void_v<R>) {
+            function(NativeArgument<std::decay_t<Args>>::convert(args[I])...);
+            return Value();
+        } else {
+            return NativeResult<R>::convert(function(NativeArgument<std::decay_t<Args>>::convert(args[I])...));
+        }
+    }
+};
+
+// Thunk generated for one C++ function: checks the argument count, converts each argument in place and
+// calls the function directly, without boxing or intermediate containers
+template<auto function>
+Value nativeThunk(const Value *args, size_t count) {
+    using Signature = NativeSignature<decltype(function)>;
+    if (count != Signature::arity) {
+        throw std::runtime_error("Funkcija očekuje " + std::to_string(Signature::arity) + " argumenata, a dobila je "
+                                 + std::to_string(count));
+    }
+    return Signature::template call<function>(args, std::make_index_sequence<Signature::arity>());
+}
+
+template<auto function>
+constexpr NativeFunction bindNative() {
+    return &nativeThunk<function>;
+}
+
+
+#endif //BOSSCRIPT_NATIVEBINDING_H
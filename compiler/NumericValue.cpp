@@ -0,0 +1,71 @@
+#include "NumericValue.h"
+#include <cmath>
+#include <limits>
+
+NumericValue NumericValue::of(double value) {
+    bool fits = value >= std::numeric_limits<int32_t>::min() && value <= std::numeric_limits<int32_t>::max();
+    if (fits && value == std::trunc(value) && !(value == 0 && std::signbit(value))) {
+        return NumericValue(static_cast<int32_t>(value));
+    }
+    return NumericValue(value, false);
+}
+
+std::optional<NumericValue> NumericValue::apply(const std::string &op, NumericValue left, NumericValue right) {
+    if (left.integer && right.integer) {
+        int32_t a = left.smallInt;
+        int32_t b = right.smallInt;
+        int32_t result;
+
+        if (op == "+" && !__builtin_add_overflow(a, b, &result)) {
+            return NumericValue(result);
+        }
+        if (op == "-" && !__builtin_sub_overflow(a, b, &result)) {
+            return NumericValue(result);
+        }
+        // 0 * -n is -0 in doubles
+        if (op == "*" && !__builtin_mul_overflow(a, b, &result) && (result != 0 || (a >= 0 && b >= 0))) {
+            return NumericValue(result);
+        }
+        // -n % m with no remainder is -0 in doubles, INT32_MIN % -1 traps
+        if (op == "%" && b != 0 && b != -1 && (a % b != 0 || a >= 0)) {
+            return NumericValue(a % b);
+        }
+        if (op == "/" && b != 0 && b != -1 && a % b == 0 && (a != 0 || b > 0)) {
+            return NumericValue(a / b);
+        }
+    }
+
+    double a = left.number;
+    double b = right.number;
+    if (op == "+") return of(a + b);
+    if (op == "-") return of(a - b);
+    if (op == "*") return of(a * b);
+    if (op == "/") return of(a / b);
+    if (op == "%") return of(std::fmod(a, b));
+    if (op == "^") return of(std::pow(a, b));
+    return std::nullopt;
+}
+
+std::optional<bool> NumericValue::compare(const std::string &op, NumericValue left, NumericValue right) {
+    if (left.integer && right.integer) {
+        int32_t a = left.smallInt;
+        int32_t b = right.smallInt;
+        if (op == "<") return a < b;
+        if (op == ">") return a > b;
+        if (op == "<=") return a <= b;
+        if (op == ">=") return a >= b;
+        if (op == "==") return a == b;
+        if (op == "!=") return a != b;
+        return std::nullopt;
+    }
+
+    double a = left.number;
+    double b = right.number;
+    if (op == "<") return a < b;
+    if (op == ">") return a > b;
+    if (op == "<=") return a <= b;
+    if (op == ">=") return a >= b;
+    if (op == "==") return a == b;
+    if (op == "!=") return a != b;
+    return std::nullopt;
+}
@@ -0,0 +1,44 @@
+#ifndef BOSSCRIPT_NUMERICVALUE_H
+#define BOSSCRIPT_NUMERICVALUE_H
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+// Number as the runtime represents it: a tagged 32-bit integer while the value is integral and in range,
+// a double otherwise. Integer operations that overflow, or whose double result would differ (-0, inexact
+// division), fall back to doubles, so results are always identical to pure double arithmetic.
+class NumericValue {
+private:
+    bool integer;
+    int32_t smallInt;
+    double number;
+
+    explicit NumericValue(int32_t value) : integer(true), smallInt(value), number(value) {}
+
+    explicit NumericValue(double value, bool) : integer(false), smallInt(0), number(value) {}
+
+public:
+    static NumericValue of(double value);
+
+    bool isInteger() const {
+        return integer;
+    }
+
+    int32_t asInteger() const {
+        return smallInt;
+    }
+
+    double toDouble() const {
+        return number;
+    }
+
+    // Returns nullopt for operators that do not produce a number
+    static std::optional<NumericValue> apply(const std::string &op, NumericValue left, NumericValue right);
+
+    // Returns nullopt for operators that do not produce a boolean
+    static std::optional<bool> compare(const std::string &op, NumericValue left, NumericValue right);
+};
+
+
+#endif //BOSSCRIPT_NUMERICVALUE_H
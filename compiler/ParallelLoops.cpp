@@ -0,0 +1,382 @@
+#include "ParallelLoops.h"
+#include "Bindings.h"
+#include "../parser/AST/ASTWalker.h"
+
+void ParallelLoops::run(Program &program) {
+    collectNumericNames(program);
+    visit(&program);
+}
+
+void ParallelLoops::printStatistics(std::ostream &os) const {
+    os << "Parallel loops: " << parallelLoops << " of " << loops << " for-each loops, " << reductions
+       << " reductions" << std::endl;
+}
+
+bool ParallelLoops::LoopBody::isLocal(const std::string &name) const {
+    for (const auto &scope: locals) {
+        if (scope.count(name)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ParallelLoops::collectNumericNames(Program &program) {
+    // Every value a name is given, nullptr if it is not known to be a number. Starting from every name,
+    // drop names given a value that is not numeric until nothing changes
+    std::vector<std::pair<std::string, Expression *>> definitions;
+    NumericLiteral number(0);
+    ASTWalker::walk(&program, [&](Statement *statement) {
+        switch (statement->kind) {
+            case NodeType::VariableDeclaration: {
+                auto declaration = static_cast<VariableDeclaration *>(statement);
+                definitions.emplace_back(declaration->name, declaration->value.get());
+                break;
+            }
+            case NodeType::FunctionParameter:
+                definitions.emplace_back(static_cast<FunctionParameter *>(statement)->identifier->symbol, nullptr);
+                break;
+            case NodeType::FunctionDeclaration:
+                definitions.emplace_back(static_cast<FunctionDeclaration *>(statement)->name->symbol, nullptr);
+                break;
+            case NodeType::ModelDefinition:
+                definitions.emplace_back(static_cast<ModelDefinitionStatement *>(statement)->className->symbol, nullptr);
+                break;
+            case NodeType::ForStatement: {
+                auto loop = static_cast<ForStatement *>(statement);
+                definitions.emplace_back(loop->counter->symbol, loop->hasIntegerCounter ? &number : nullptr);
+                break;
+            }
+            case NodeType::ForEachStatement: {
+                auto loop = static_cast<ForEachStatement *>(statement);
+                bool numeric = loop->elementKind && *loop->elementKind != ElementKind::Generic;
+                definitions.emplace_back(loop->element->symbol, numeric ? &number : nullptr);
+                break;
+            }
+            case NodeType::AssignmentExpression: {
+                auto assignment = static_cast<AssignmentExpression *>(statement);
+                if (assignment->assignee->kind == NodeType::Identifier) {
+                    definitions.emplace_back(static_cast<Identifier *>(assignment->assignee.get())->symbol, assignment->value.get());
+                }
+                break;
+            }
+            default:
+                break;
+        }
+        return true;
+    });
+
+    for (const auto &[name, value]: definitions) {
+        numericNames.insert(name);
+    }
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (const auto &[name, value]: definitions) {
+            if (numericNames.count(name) && (!value || !isNumeric(value))) {
+                numericNames.erase(name);
+                changed = true;
+            }
+        }
+    }
+}
+
+bool ParallelLoops::isNumeric(Expression *expression) const {
+    switch (expression->kind) {
+        case NodeType::NumericLiteral:
+            return true;
+        case NodeType::Identifier:
+            return numericNames.count(static_cast<Identifier *>(expression)->symbol);
+        case NodeType::UnaryExpression: {
+            auto unary = static_cast<UnaryExpression *>(expression);
+            return unary->mOperator != "!" && isNumeric(unary->operand.get());
+        }
+        case NodeType::BinaryExpression: {
+            static const std::set<std::string> arithmetic = {"+", "-", "*", "/", "%", "^"};
+            auto binary = static_cast<BinaryExpression *>(expression);
+            return arithmetic.count(binary->mOperator) && isNumeric(binary->left.get()) && isNumeric(binary->right.get());
+        }
+        default:
+            return false;
+    }
+}
+
+std::optional<bool> ParallelLoops::lookup(const std::string &name) const {
+    for (auto scope = scopes.rbegin(); scope != scopes.rend(); scope++) {
+        auto binding = scope->find(name);
+        if (binding != scope->end()) {
+            return binding->second;
+        }
+    }
+    return std::nullopt;
+}
+
+void ParallelLoops::visit(Statement *node) {
+    switch (node->kind) {
+        case NodeType::Program:
+        case NodeType::Block:
+            scopes.emplace_back();
+            ASTWalker::forEachChild(node, [this](Statement *child) {
+                visit(child);
+            });
+            scopes.pop_back();
+            return;
+        case NodeType::VariableStatement: {
+            auto statement = static_cast<VariableStatement *>(node);
+            for (const auto &declaration: statement->declarations) {
+                if (declaration->value) {
+                    visit(declaration->value.get());
+                }
+                scopes.back()[declaration->name] = statement->isConstant;
+            }
+            return;
+        }
+        case NodeType::FunctionDeclaration:
+        case NodeType::FunctionExpression: {
+            Statement *body;
+            const std::vector<std::unique_ptr<FunctionParameter>> *params;
+            if (node->kind == NodeType::FunctionDeclaration) {
+                auto function = static_cast<FunctionDeclaration *>(node);
+                scopes.back()[function->name->symbol] = false;
+                body = function->body.get();
+                params = &function->params;
+            } else {
+                auto function = static_cast<FunctionExpression *>(node);
+                body = function->body.get();
+                params = &function->params;
+            }
+            scopes.emplace_back();
+            for (const auto &param: *params) {
+                scopes.back()[param->identifier->symbol] = false;
+            }
+            visit(body);
+            scopes.pop_back();
+            return;
+        }
+        case NodeType::ModelDefinition:
+            scopes.back()[static_cast<ModelDefinitionStatement *>(node)->className->symbol] = false;
+            scopes.emplace_back();
+            ASTWalker::forEachChild(node, [this](Statement *child) {
+                visit(child);
+            });
+            scopes.pop_back();
+            return;
+        case NodeType::ForStatement: {
+            auto loop = static_cast<ForStatement *>(node);
+            for (auto bound: {loop->startValue.get(), loop->endValue.get(), loop->step.get()}) {
+                if (bound) visit(bound);
+            }
+            scopes.push_back({{loop->counter->symbol, false}});
+            visit(loop->body.get());
+            scopes.pop_back();
+            return;
+        }
+        case NodeType::ForEachStatement: {
+            auto loop = static_cast<ForEachStatement *>(node);
+            visit(loop->iterable.get());
+            analyze(loop);
+            const std::string &element = loop->element->symbol;
+            scopes.push_back({{element, !Bindings::assignedNames(loop->body.get()).count(element)}});
+            visit(loop->body.get());
+            scopes.pop_back();
+            return;
+        }
+        default:
+            ASTWalker::forEachChild(node, [this](Statement *child) {
+                visit(child);
+            });
+            return;
+    }
+}
+
+void ParallelLoops::analyze(ForEachStatement *loop) {
+    loops++;
+    LoopBody body;
+    body.locals.push_back({loop->element->symbol});
+    check(loop->body.get(), body, false);
+    if (body.pure) {
+        loop->isParallel = true;
+        loop->reductions = body.reductions;
+        parallelLoops++;
+        reductions += body.reductions.size();
+    }
+}
+
+void ParallelLoops::reduce(const std::string &target, const std::string &op, LoopBody &body) {
+    auto konst = lookup(target);
+    if (!konst || *konst) {
+        body.pure = false;
+        return;
+    }
+    auto existing = body.reductionOperators.find(target);
+    if (existing == body.reductionOperators.end()) {
+        body.reductionOperators[target] = op;
+        body.reductions.push_back(target);
+    }
+    else if (existing->second != op) {
+        body.pure = false;
+    }
+}
+
+void ParallelLoops::check(Statement *node, LoopBody &body, bool asStatement) {
+    if (!body.pure) {
+        return;
+    }
+    switch (node->kind) {
+        case NodeType::Block:
+            body.locals.emplace_back();
+            for (const auto &statement: static_cast<BlockStatement *>(node)->body) {
+                check(statement.get(), body, true);
+            }
+            body.locals.pop_back();
+            return;
+        case NodeType::VariableStatement:
+            for (const auto &declaration: static_cast<VariableStatement *>(node)->declarations) {
+                if (declaration->value) {
+                    check(declaration->value.get(), body, false);
+                }
+                body.locals.back().insert(declaration->name);
+            }
+            return;
+        case NodeType::Identifier: {
+            const std::string &name = static_cast<Identifier *>(node)->symbol;
+            if (!body.isLocal(name) && lookup(name) != std::optional<bool>(true)) {
+                body.pure = false;
+            }
+            return;
+        }
+        case NodeType::AssignmentExpression: {
+            auto assignment = static_cast<AssignmentExpression *>(node);
+            if (assignment->assignee->kind != NodeType::Identifier) {
+                body.pure = false;
+                return;
+            }
+            const std::string &target = static_cast<Identifier *>(assignment->assignee.get())->symbol;
+            if (body.isLocal(target)) {
+                check(assignment->value.get(), body, false);
+                return;
+            }
+            // A reduction's partial value must not be observed, so its update cannot be used as a value
+            if (!asStatement) {
+                body.pure = false;
+                return;
+            }
+            const std::string &op = assignment->assignmentOperator;
+            if (op == "+=" || op == "-=" || op == "*=") {
+                if (op != "*=" && (!numericNames.count(target) || !isNumeric(assignment->value.get()))) {
+                    body.pure = false;
+                    return;
+                }
+                reduce(target, op == "*=" ? "*" : "+", body);
+                check(assignment->value.get(), body, false);
+                return;
+            }
+            // s = s + x, s = s - x, s = s * x. Not s = x + s: + also concatenates strings, which does not commute
+            auto binary = dynamic_cast<BinaryExpression *>(assignment->value.get());
+            if (op != "=" || !binary || (binary->mOperator != "+" && binary->mOperator != "-" && binary->mOperator != "*")) {
+                body.pure = false;
+                return;
+            }
+            auto isTarget = [&target](Expression *expression) {
+                return expression->kind == NodeType::Identifier && static_cast<Identifier *>(expression)->symbol == target;
+            };
+            std::string family = binary->mOperator == "*" ? "*" : "+";
+            if (family == "+" && (!numericNames.count(target) || !isNumeric(binary->right.get()))) {
+                body.pure = false;
+            }
+            else if (isTarget(binary->left.get())) {
+                reduce(target, family, body);
+                check(binary->right.get(), body, false);
+            }
+            else {
+                body.pure = false;
+            }
+            return;
+        }
+        case NodeType::UnaryExpression: {
+            auto unary = static_cast<UnaryExpression *>(node);
+            if (unary->mOperator != "++" && unary->mOperator != "--") {
+                check(unary->operand.get(), body, false);
+                return;
+            }
+            if (unary->operand->kind != NodeType::Identifier) {
+                body.pure = false;
+                return;
+            }
+            const std::string &target = static_cast<Identifier *>(unary->operand.get())->symbol;
+            if (body.isLocal(target)) {
+                return;
+            }
+            if (!asStatement || !numericNames.count(target)) {
+                body.pure = false;
+                return;
+            }
+            reduce(target, "+", body);
+            return;
+        }
+        case NodeType::MemberExpression: {
+            auto member = static_cast<MemberExpression *>(node);
+            check(member->targetObject.get(), body, false);
+            if (member->isComputed) {
+                check(member->property.get(), body, false);
+            }
+            return;
+        }
+        case NodeType::IfStatement:
+        case NodeType::UnlessStatement: {
+            Expression *condition;
+            Statement *consequent;
+            Statement *alternate;
+            if (node->kind == NodeType::IfStatement) {
+                auto statement = static_cast<IfStatement *>(node);
+                condition = statement->condition.get();
+                consequent = statement->consequent.get();
+                alternate = statement->alternate.get();
+            } else {
+                auto statement = static_cast<UnlessStatement *>(node);
+                condition = statement->condition.get();
+                consequent = statement->consequent.get();
+                alternate = statement->alternate.get();
+            }
+            check(condition, body, false);
+            check(consequent, body, true);
+            if (alternate) {
+                check(alternate, body, true);
+            }
+            return;
+        }
+        case NodeType::ForStatement: {
+            auto loop = static_cast<ForStatement *>(node);
+            for (auto bound: {loop->startValue.get(), loop->endValue.get(), loop->step.get()}) {
+                if (bound) check(bound, body, false);
+            }
+            body.locals.push_back({loop->counter->symbol});
+            check(loop->body.get(), body, false);
+            body.locals.pop_back();
+            return;
+        }
+        case NodeType::ForEachStatement: {
+            auto loop = static_cast<ForEachStatement *>(node);
+            check(loop->iterable.get(), body, false);
+            body.locals.push_back({loop->element->symbol});
+            check(loop->body.get(), body, false);
+            body.locals.pop_back();
+            return;
+        }
+        case NodeType::CallExpression:
+        case NodeType::FunctionDeclaration:
+        case NodeType::FunctionExpression:
+        case NodeType::ModelDefinition:
+        case NodeType::ReturnStatement:
+        case NodeType::BreakStatement:
+        case NodeType::ImportStatement:
+        case NodeType::Javascript:
+            body.pure = false;
+            return;
+        default:
+            ASTWalker::forEachChild(node, [this, &body](Statement *child) {
+                check(child, body, false);
+            });
+            return;
+    }
+}
@@ -0,0 +1,67 @@
+#ifndef BOSSCRIPT_PARALLELLOOPS_H
+#define BOSSCRIPT_PARALLELLOOPS_H
+
+#include <map>
+#include <optional>
+#include <set>
+#include <vector>
+#include "Pass.h"
+
+// Marks for-each loops whose iterations can run in any order, on different workers. The body may read
+// konst bindings from outside the loop and anything it declares itself. Outer variables it writes have to
+// be reduction targets: updated only in expression statements (s += x, s -= x, s *= x, s = s + x, ++s)
+// with one associative operator, and not read anywhere else in the body. Each worker then keeps its own
+// partial value and the partials are combined after the loop. + also concatenates strings, where
+// "" + 1 + 2 is not "" + (1 + 2), so a +, - or ++ reduction needs a target and added values that are
+// always numbers: numeric literals, elements of a for-each over a numeric array (see ElementKinds) and
+// arithmetic on them, or names that are only ever given such values.
+//
+// Calls, property and element stores, nested functions, vrati and prekid make a loop sequential.
+class ParallelLoops : public Pass {
+private:
+    class LoopBody {
+    public:
+        std::vector<std::set<std::string>> locals;
+        std::map<std::string, std::string> reductionOperators;
+        std::vector<std::string> reductions;
+        bool pure = true;
+
+        bool isLocal(const std::string &name) const;
+    };
+
+    // Bindings outside the loop being analyzed, name -> declared with konst. Elements of enclosing for-each
+    // loops that are never assigned count as konst
+    std::vector<std::map<std::string, bool>> scopes;
+    // Names whose every declaration and assignment in the program gives them a number
+    std::set<std::string> numericNames;
+    size_t loops = 0;
+    size_t parallelLoops = 0;
+    size_t reductions = 0;
+
+    void collectNumericNames(Program &program);
+
+    bool isNumeric(Expression *expression) const;
+
+    void visit(Statement *node);
+
+    void analyze(ForEachStatement *loop);
+
+    void check(Statement *node, LoopBody &body, bool asStatement);
+
+    void reduce(const std::string &target, const std::string &op, LoopBody &body);
+
+    // Whether an outer binding is konst, nullopt if the name is not declared
+    std::optional<bool> lookup(const std::string &name) const;
+
+public:
+    std::string name() const override {
+        return "parallel-loops";
+    }
+
+    void run(Program &program) override;
+
+    void printStatistics(std::ostream &os) const override;
+};
+
+
+#endif //BOSSCRIPT_PARALLELLOOPS_H
@@ -0,0 +1,20 @@
+#ifndef BOSSCRIPT_PASS_H
+#define BOSSCRIPT_PASS_H
+
+#include <string>
+#include <ostream>
+#include "../parser/AST/Statements.h"
+
+class Pass {
+public:
+    virtual ~Pass() = default;
+
+    virtual std::string name() const = 0;
+
+    virtual void run(Program &program) = 0;
+
+    virtual void printStatistics(std::ostream &) const {}
+};
+
+
+#endif //BOSSCRIPT_PASS_H
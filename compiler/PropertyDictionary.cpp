@@ -0,0 +1,159 @@
+#include "PropertyDictionary.h"
+#include <algorithm>
+#include <bit>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+uint64_t PropertyDictionary::hash(uint32_t key) {
+    uint64_t hash = key * 0x9E3779B97F4A7C15ull;
+    return hash ^ (hash >> 29);
+}
+
+uint32_t PropertyDictionary::match(const int8_t *group, int8_t value) {
+#ifdef __SSE2__
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(group));
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(value)));
+#else
+    uint32_t bits = 0;
+    for (size_t i = 0; i < groupSize; i++) {
+        bits |= static_cast<uint32_t>(group[i] == value) << i;
+    }
+    return bits;
+#endif
+}
+
+uint32_t PropertyDictionary::matchFree(const int8_t *group) {
+    // Full slots hold 7 hash bits, so only empty and deleted slots have the sign bit set
+#ifdef __SSE2__
+    return _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(group)));
+#else
+    uint32_t bits = 0;
+    for (size_t i = 0; i < groupSize; i++) {
+        bits |= static_cast<uint32_t>(group[i] < 0) << i;
+    }
+    return bits;
+#endif
+}
+
+size_t PropertyDictionary::findSlot(uint32_t key) const {
+    if (control.empty()) {
+        return notFound;
+    }
+    uint64_t keyHash = hash(key);
+    auto tag = static_cast<int8_t>(keyHash & 0x7F);
+    size_t groups = control.size() / groupSize;
+    size_t group = (keyHash >> 7) & (groups - 1);
+
+    // Triangular probing visits every group when the group count is a power of two
+    for (size_t probe = 1; probe <= groups; probe++) {
+        const int8_t *bytes = control.data() + group * groupSize;
+        for (uint32_t bits = match(bytes, tag); bits != 0; bits &= bits - 1) {
+            size_t slot = group * groupSize + std::countr_zero(bits);
+            if (slots[slot].key == key) {
+                return slot;
+            }
+        }
+        if (match(bytes, emptySlot) != 0) {
+            return notFound;
+        }
+        group = (group + probe) & (groups - 1);
+    }
+    return notFound;
+}
+
+size_t PropertyDictionary::freeSlot(uint64_t keyHash) const {
+    size_t groups = control.size() / groupSize;
+    size_t group = (keyHash >> 7) & (groups - 1);
+    for (size_t probe = 1;; probe++) {
+        if (uint32_t bits = matchFree(control.data() + group * groupSize)) {
+            return group * groupSize + std::countr_zero(bits);
+        }
+        group = (group + probe) & (groups - 1);
+    }
+}
+
+void PropertyDictionary::compactEntries() {
+    size_t kept = 0;
+    for (const auto &entry: entries) {
+        if (!entry.erased) {
+            entryOf[findSlot(entry.key)] = kept;
+            entries[kept++] = entry;
+        }
+    }
+    entries.resize(kept);
+}
+
+void PropertyDictionary::rehash(size_t capacity) {
+    compactEntries();
+
+    std::vector<int8_t> oldControl = std::move(control);
+    std::vector<Slot> oldSlots = std::move(slots);
+    std::vector<uint32_t> oldEntryOf = std::move(entryOf);
+    control.assign(capacity, emptySlot);
+    slots.assign(capacity, Slot{0, 0});
+    entryOf.assign(capacity, 0);
+    tombstones = 0;
+
+    for (size_t old = 0; old < oldControl.size(); old++) {
+        if (oldControl[old] < 0) {
+            continue;
+        }
+        size_t slot = freeSlot(hash(oldSlots[old].key));
+        control[slot] = oldControl[old];
+        slots[slot] = oldSlots[old];
+        entryOf[slot] = oldEntryOf[old];
+    }
+}
+
+bool PropertyDictionary::insert(uint32_t key, uint32_t value) {
+    if (size_t slot = findSlot(key); slot != notFound) {
+        slots[slot].value = value;
+        return false;
+    }
+
+    // At most 7/8 of the slots are in use, so every probe sequence reaches an empty slot
+    if ((live + tombstones + 1) * 8 > capacity() * 7) {
+        if (capacity() == 0) {
+            rehash(groupSize);
+        } else {
+            rehash((live + 1) * 2 > capacity() ? capacity() * 2 : capacity());
+        }
+    }
+
+    uint64_t keyHash = hash(key);
+    size_t slot = freeSlot(keyHash);
+    if (control[slot] == deletedSlot) {
+        tombstones--;
+    }
+    control[slot] = static_cast<int8_t>(keyHash & 0x7F);
+    slots[slot] = Slot{key, value};
+    entryOf[slot] = entries.size();
+    entries.push_back(Entry{key, false});
+    live++;
+    return true;
+}
+
+bool PropertyDictionary::erase(uint32_t key) {
+    size_t slot = findSlot(key);
+    if (slot == notFound) {
+        return false;
+    }
+    entries[entryOf[slot]].erased = true;
+    control[slot] = deletedSlot;
+    live--;
+    tombstones++;
+    // Inserting into a tombstone does not rehash, so erased entries would pile up without this
+    if (entries.size() - live > std::max(live, groupSize)) {
+        compactEntries();
+    }
+    return true;
+}
+
+void PropertyDictionary::forEach(const std::function<void(uint32_t, uint32_t)> &visit) const {
+    for (const auto &entry: entries) {
+        if (!entry.erased) {
+            visit(entry.key, slots[findSlot(entry.key)].value);
+        }
+    }
+}
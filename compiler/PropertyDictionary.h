@@ -0,0 +1,90 @@
+#ifndef BOSSCRIPT_PROPERTYDICTIONARY_H
+#define BOSSCRIPT_PROPERTYDICTIONARY_H
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <vector>
+
+// Property storage of dictionary-mode objects, keyed by interned string ids (see StringTable).
+// Open addressing in the style of SwissTable: slots are split into groups of 16 with one control byte per slot,
+// holding 7 bits of the key's hash for full slots. A lookup compares a whole group of control bytes at once
+// (SSE2 when available) and only checks keys of slots whose hash bits match. Keys are also kept in a separate
+// array in insertion order, which is the order properties are iterated in.
+class PropertyDictionary {
+public:
+    static constexpr size_t groupSize = 16;
+
+private:
+    static constexpr int8_t emptySlot = -128;
+    static constexpr int8_t deletedSlot = -2;
+    // Returned by findSlot instead of an optional, which would be written to and reloaded from the stack
+    static constexpr size_t notFound = SIZE_MAX;
+
+    class Slot {
+    public:
+        uint32_t key;
+        uint32_t value;
+    };
+
+    class Entry {
+    public:
+        uint32_t key;
+        bool erased;
+    };
+
+    std::vector<int8_t> control;
+    std::vector<Slot> slots;
+    // Keys in insertion order. Erased ones are dropped on rehash, or once they outnumber the live ones
+    std::vector<Entry> entries;
+    // Index into entries of the key in each full slot
+    std::vector<uint32_t> entryOf;
+    size_t live = 0;
+    size_t tombstones = 0;
+
+    static uint64_t hash(uint32_t key);
+
+    // Bit i is set if control byte i of the group equals value
+    static uint32_t match(const int8_t *group, int8_t value);
+
+    // Bit i is set if slot i of the group is empty or deleted
+    static uint32_t matchFree(const int8_t *group);
+
+    size_t findSlot(uint32_t key) const;
+
+    size_t freeSlot(uint64_t keyHash) const;
+
+    // Drops erased entries and points entryOf at the new indices
+    void compactEntries();
+
+    void rehash(size_t capacity);
+
+public:
+    // Defined here so that callers can keep the optional in registers
+    std::optional<uint32_t> find(uint32_t key) const {
+        size_t slot = findSlot(key);
+        if (slot == notFound) {
+            return std::nullopt;
+        }
+        return slots[slot].value;
+    }
+
+    // Returns false if the key was already present, its value is replaced and it keeps its position
+    bool insert(uint32_t key, uint32_t value);
+
+    bool erase(uint32_t key);
+
+    size_t size() const {
+        return live;
+    }
+
+    size_t capacity() const {
+        return control.size();
+    }
+
+    // Visits entries in insertion order
+    void forEach(const std::function<void(uint32_t key, uint32_t value)> &visit) const;
+};
+
+
+#endif //BOSSCRIPT_PROPERTYDICTIONARY_H
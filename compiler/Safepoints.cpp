@@ -0,0 +1,105 @@
+#include "Safepoints.h"
+#include "NumericValue.h"
+#include "../parser/AST/ASTWalker.h"
+
+void Safepoints::run(Program &program) {
+    cost(&program);
+}
+
+void Safepoints::printStatistics(std::ostream &os) const {
+    os << "Safepoints: " << loopChecks << " loop back-edges, " << entryChecks << " function entries, "
+       << uncheckedLoops << " loops without checks" << std::endl;
+}
+
+std::optional<size_t> Safepoints::tripCount(ForStatement *loop) {
+    auto literal = [](Expression *expression) -> std::optional<int64_t> {
+        if (expression == nullptr || expression->kind != NodeType::NumericLiteral) {
+            return std::nullopt;
+        }
+        auto value = NumericValue::of(static_cast<NumericLiteral *>(expression)->value);
+        if (!value.isInteger()) {
+            return std::nullopt;
+        }
+        return value.asInteger();
+    };
+
+    auto start = literal(loop->startValue.get());
+    auto end = literal(loop->endValue.get());
+    auto step = loop->step ? literal(loop->step.get()) : std::optional<int64_t>(1);
+    if (!loop->isCounted || !start || !end || !step || *step == 0) {
+        return std::nullopt;
+    }
+    if (*step > 0) {
+        return *end < *start ? 0 : static_cast<size_t>((*end - *start) / *step + 1);
+    }
+    return *start < *end ? 0 : static_cast<size_t>((*start - *end) / -*step + 1);
+}
+
+size_t Safepoints::functionCost(Statement *body, size_t &safepointCost) {
+    // Call sites cannot be resolved statically, so every function charges its own body on entry. Its
+    // callers only pay for creating it
+    safepointCost = std::max<size_t>(cost(body), 1);
+    entryChecks++;
+    return 1;
+}
+
+size_t Safepoints::cost(Statement *node) {
+    auto sum = [this](std::initializer_list<Statement *> nodes) {
+        size_t total = 0;
+        for (auto child: nodes) {
+            if (child) total += cost(child);
+        }
+        return total;
+    };
+
+    switch (node->kind) {
+        case NodeType::FunctionDeclaration: {
+            auto function = static_cast<FunctionDeclaration *>(node);
+            return functionCost(function->body.get(), function->safepointCost);
+        }
+        case NodeType::FunctionExpression: {
+            auto function = static_cast<FunctionExpression *>(node);
+            return functionCost(function->body.get(), function->safepointCost);
+        }
+        case NodeType::WhileStatement: {
+            auto loop = static_cast<WhileStatement *>(node);
+            loop->safepointCost = 1 + sum({loop->condition.get(), loop->body.get()});
+            loopChecks++;
+            return loop->safepointCost;
+        }
+        case NodeType::DoWhileStatement: {
+            auto loop = static_cast<DoWhileStatement *>(node);
+            loop->safepointCost = 1 + sum({loop->body.get(), loop->condition.get()});
+            loopChecks++;
+            return loop->safepointCost;
+        }
+        case NodeType::ForStatement: {
+            auto loop = static_cast<ForStatement *>(node);
+            size_t header = 1 + sum({loop->startValue.get(), loop->endValue.get(), loop->step.get()});
+            // The counter update and the compare cost one node per iteration
+            size_t iteration = 1 + cost(loop->body.get());
+            auto trips = tripCount(loop);
+            if (trips && *trips <= maxUncheckedCost / iteration) {
+                uncheckedLoops++;
+                return header + *trips * iteration;
+            }
+            loop->safepointCost = iteration;
+            loopChecks++;
+            return header + iteration;
+        }
+        case NodeType::ForEachStatement: {
+            auto loop = static_cast<ForEachStatement *>(node);
+            size_t iterable = cost(loop->iterable.get());
+            loop->safepointCost = 1 + cost(loop->body.get());
+            loopChecks++;
+            return 1 + iterable + loop->safepointCost;
+        }
+        default: {
+            size_t total = 1;
+            ASTWalker::forEachChild(node, [this, &total](Statement *child) {
+                total += cost(child);
+            });
+            return total;
+        }
+    }
+}
@@ -0,0 +1,38 @@
+#ifndef BOSSCRIPT_SAFEPOINTS_H
+#define BOSSCRIPT_SAFEPOINTS_H
+
+#include <optional>
+#include "Pass.h"
+
+// Places budget checks so that no script runs unbounded between two of them: on the back-edge of every
+// loop and on entry of every function. Each check charges the cost of the code since the previous one,
+// counted in AST nodes.
+//
+// A counted loop with literal bounds whose total cost is small gets no back-edge check, its iterations
+// are charged at the enclosing check instead.
+class Safepoints : public Pass {
+private:
+    static constexpr size_t maxUncheckedCost = 4096;
+    size_t loopChecks = 0;
+    size_t entryChecks = 0;
+    size_t uncheckedLoops = 0;
+
+    // Cost of running node once, up to the first check inside it. Places checks in loops and functions below node
+    size_t cost(Statement *node);
+
+    size_t functionCost(Statement *body, size_t &safepointCost);
+
+    static std::optional<size_t> tripCount(ForStatement *loop);
+
+public:
+    std::string name() const override {
+        return "safepoints";
+    }
+
+    void run(Program &program) override;
+
+    void printStatistics(std::ostream &os) const override;
+};
+
+
+#endif //BOSSCRIPT_SAFEPOINTS_H
@@ -0,0 +1,303 @@
+#include "ScalarReplacement.h"
+#include "../parser/AST/ASTWalker.h"
+
+void ScalarReplacement::run(Program &program) {
+    ASTWalker::walk(&program, [this](Statement *statement) {
+        if (statement->kind == NodeType::FunctionDeclaration) {
+            auto declaration = static_cast<FunctionDeclaration *>(statement);
+            replaceInFunction(declaration->body.get(), declaration->params);
+        }
+        else if (statement->kind == NodeType::FunctionExpression) {
+            auto expression = static_cast<FunctionExpression *>(statement);
+            replaceInFunction(expression->body.get(), expression->params);
+        }
+        return true;
+    });
+    replaceInFunction(&program, {});
+}
+
+void ScalarReplacement::printStatistics(std::ostream &os) const {
+    os << "Scalar replacement: " << replaced << " model allocations removed" << std::endl;
+}
+
+std::string ScalarReplacement::scalarName(const std::string &variable, const std::string &field) {
+    // '#' cannot appear in an identifier, so the name never clashes with a user variable
+    return variable + "#" + field;
+}
+
+const std::optional<ScalarReplacement::ConstructorFields> &ScalarReplacement::constructorFields(const ModelDefinitionStatement *model) {
+    auto cached = constructors.find(model);
+    if (cached != constructors.end()) {
+        return cached->second;
+    }
+
+    auto &result = constructors[model];
+    if (model->parentClassName) {
+        return result;
+    }
+    for (auto block: {model->privateBlock.get(), model->publicBlock.get()}) {
+        if (!block) continue;
+        for (const auto &member: block->getBody()) {
+            if (member->kind != NodeType::VariableStatement) continue;
+            for (const auto &declaration: static_cast<VariableStatement *>(member.get())->declarations) {
+                if (declaration->value) return result;
+            }
+        }
+    }
+
+    const auto &params = model->constructor->params;
+    ConstructorFields fields(params.size());
+    std::set<std::string> assigned;
+    for (const auto &param: params) {
+        if (param->typeAnnotation) return result;
+    }
+
+    for (const auto &statement: model->constructor->body->body) {
+        if (statement->kind == NodeType::EmptyStatement) continue;
+        if (statement->kind != NodeType::AssignmentExpression) return result;
+
+        auto assignment = static_cast<AssignmentExpression *>(statement.get());
+        if (assignment->assignmentOperator != "=" || assignment->assignee->kind != NodeType::MemberExpression
+            || assignment->value->kind != NodeType::Identifier) {
+            return result;
+        }
+        auto member = static_cast<MemberExpression *>(assignment->assignee.get());
+        if (member->isComputed || member->targetObject->kind != NodeType::Identifier
+            || static_cast<Identifier *>(member->targetObject.get())->symbol != "@") {
+            return result;
+        }
+        const std::string &field = static_cast<Identifier *>(member->property.get())->symbol;
+        const std::string &source = static_cast<Identifier *>(assignment->value.get())->symbol;
+        auto param = std::find_if(params.begin(), params.end(), [&source](const auto &p) {
+            return p->identifier->symbol == source;
+        });
+        if (!model->layout->slotOf(field) || param == params.end() || !assigned.insert(field).second) {
+            return result;
+        }
+        auto &target = fields[param - params.begin()];
+        if (target) {
+            return result;
+        }
+        target = field;
+    }
+
+    result = fields;
+    return result;
+}
+
+void ScalarReplacement::replaceInFunction(Statement *body, const std::vector<std::unique_ptr<FunctionParameter>> &params) {
+    class Candidate {
+    public:
+        VariableStatement *statement;
+        const ModelDefinitionStatement *model;
+        bool stored = false;
+        // d.x accesses after the declaration in the block declaring d, other uses of the name are not this variable
+        std::set<const Statement *> accesses;
+    };
+    std::map<std::string, Candidate> candidates;
+    std::set<std::string> rejected;
+    std::set<std::string> declared;
+
+    auto isNestedFunction = [](Statement *statement) {
+        return statement->kind == NodeType::FunctionDeclaration || statement->kind == NodeType::FunctionExpression
+               || statement->kind == NodeType::ModelDefinition;
+    };
+
+    // Allocations bound by a declaration: var d = Model(...)
+    ASTWalker::walk(body, [&](Statement *statement) {
+        if (isNestedFunction(statement)) {
+            return false;
+        }
+        if (statement->kind != NodeType::VariableStatement) {
+            return true;
+        }
+        auto variables = static_cast<VariableStatement *>(statement);
+        for (const auto &declaration: variables->declarations) {
+            if (!declared.insert(declaration->name).second) {
+                rejected.insert(declaration->name);
+            }
+            auto call = dynamic_cast<CallExpression *>(declaration->value.get());
+            if (!call || call->callee->kind != NodeType::Identifier) {
+                continue;
+            }
+            auto model = models.modelOf(static_cast<Identifier *>(call->callee.get())->symbol);
+            if (!model || !constructorFields(model) || call->args.size() != model->constructor->params.size()) {
+                continue;
+            }
+            const auto &fields = *constructorFields(model);
+            bool droppable = true;
+            for (size_t i = 0; i < fields.size(); i++) {
+                auto kind = call->args[i]->kind;
+                if (!fields[i] && kind != NodeType::NumericLiteral && kind != NodeType::StringLiteral
+                    && kind != NodeType::BooleanLiteral && kind != NodeType::NullLiteral) {
+                    droppable = false;
+                }
+            }
+            if (droppable) {
+                candidates.emplace(declaration->name, Candidate{variables, model, false, {}});
+            }
+        }
+        return true;
+    });
+    for (const auto &param: params) {
+        rejected.insert(param->identifier->symbol);
+    }
+
+    ASTWalker::walk(body, [&](Statement *statement) {
+        if (isNestedFunction(statement)) {
+            return false;
+        }
+        std::vector<std::unique_ptr<Statement>> *statements = nullptr;
+        if (statement->kind == NodeType::Program) {
+            statements = &static_cast<Program *>(statement)->body;
+        } else if (statement->kind == NodeType::Block) {
+            statements = &static_cast<BlockStatement *>(statement)->body;
+        } else {
+            return true;
+        }
+        for (size_t i = 0; i < statements->size(); i++) {
+            auto variables = (*statements)[i].get();
+            if (variables->kind != NodeType::VariableStatement) continue;
+            for (const auto &declaration: static_cast<VariableStatement *>(variables)->declarations) {
+                auto candidate = candidates.find(declaration->name);
+                if (candidate == candidates.end() || candidate->second.statement != variables) continue;
+                for (size_t j = i + 1; j < statements->size(); j++) {
+                    ASTWalker::walk((*statements)[j].get(), [&](Statement *inner) {
+                        if (isNestedFunction(inner)) {
+                            return false;
+                        }
+                        auto member = dynamic_cast<MemberExpression *>(inner);
+                        if (member && member->targetObject->kind == NodeType::Identifier
+                            && static_cast<Identifier *>(member->targetObject.get())->symbol == declaration->name) {
+                            candidate->second.accesses.insert(member);
+                        }
+                        return true;
+                    });
+                }
+            }
+        }
+        return true;
+    });
+
+    // Any use other than a field access in the candidate's scope lets the instance escape
+    auto isFieldAccess = [&candidates](Statement *statement, bool nested) -> Candidate * {
+        auto member = dynamic_cast<MemberExpression *>(statement);
+        if (nested || !member || member->isComputed || member->targetObject->kind != NodeType::Identifier) {
+            return nullptr;
+        }
+        auto candidate = candidates.find(static_cast<Identifier *>(member->targetObject.get())->symbol);
+        if (candidate == candidates.end() || !candidate->second.accesses.count(member)
+            || !candidate->second.model->layout->slotOf(static_cast<Identifier *>(member->property.get())->symbol)) {
+            return nullptr;
+        }
+        return &candidate->second;
+    };
+
+    std::function<void(Statement *, bool)> scan = [&](Statement *node, bool nested) {
+        ASTWalker::walk(node, [&](Statement *statement) {
+            if (isNestedFunction(statement) && statement != node) {
+                scan(statement, true);
+                return false;
+            }
+            switch (statement->kind) {
+                case NodeType::Identifier:
+                    rejected.insert(static_cast<Identifier *>(statement)->symbol);
+                    return false;
+                case NodeType::VariableDeclaration: {
+                    auto declaration = static_cast<VariableDeclaration *>(statement);
+                    if (nested) rejected.insert(declaration->name);
+                    return true;
+                }
+                case NodeType::FunctionParameter:
+                    rejected.insert(static_cast<FunctionParameter *>(statement)->identifier->symbol);
+                    return false;
+                case NodeType::AssignmentExpression: {
+                    auto assignment = static_cast<AssignmentExpression *>(statement);
+                    if (auto candidate = isFieldAccess(assignment->assignee.get(), nested)) {
+                        candidate->stored = true;
+                        scan(assignment->value.get(), nested);
+                        return false;
+                    }
+                    return true;
+                }
+                case NodeType::UnaryExpression: {
+                    auto unary = static_cast<UnaryExpression *>(statement);
+                    if (auto candidate = isFieldAccess(unary->operand.get(), nested)) {
+                        if (unary->mOperator == "++" || unary->mOperator == "--") candidate->stored = true;
+                        return false;
+                    }
+                    return true;
+                }
+                case NodeType::MemberExpression: {
+                    auto member = static_cast<MemberExpression *>(statement);
+                    if (isFieldAccess(member, nested)) {
+                        return false;
+                    }
+                    scan(member->targetObject.get(), nested);
+                    if (member->isComputed) {
+                        scan(member->property.get(), nested);
+                    }
+                    return false;
+                }
+                default:
+                    return true;
+            }
+        });
+    };
+    scan(body, false);
+
+    for (auto candidate = candidates.begin(); candidate != candidates.end();) {
+        bool constantWithStores = candidate->second.statement->isConstant && candidate->second.stored;
+        if (rejected.count(candidate->first) || constantWithStores) {
+            candidate = candidates.erase(candidate);
+        } else {
+            ++candidate;
+        }
+    }
+    if (candidates.empty()) {
+        return;
+    }
+
+    ASTWalker::walk(body, [&](Statement *statement) {
+        if (isNestedFunction(statement)) {
+            return false;
+        }
+        if (statement->kind != NodeType::VariableStatement) {
+            return true;
+        }
+        std::vector<std::unique_ptr<VariableDeclaration>> declarations;
+        for (auto &declaration: static_cast<VariableStatement *>(statement)->declarations) {
+            auto candidate = candidates.find(declaration->name);
+            if (candidate == candidates.end()) {
+                declarations.emplace_back(std::move(declaration));
+                continue;
+            }
+            auto call = static_cast<CallExpression *>(declaration->value.get());
+            const auto &fields = *constructorFields(candidate->second.model);
+            std::set<std::string> initialized;
+            for (size_t i = 0; i < fields.size(); i++) {
+                if (fields[i]) {
+                    declarations.emplace_back(std::make_unique<VariableDeclaration>(scalarName(declaration->name, *fields[i]), std::move(call->args[i])));
+                    initialized.insert(*fields[i]);
+                }
+            }
+            for (const auto &field: candidate->second.model->layout->fields) {
+                if (!initialized.count(field)) {
+                    declarations.emplace_back(std::make_unique<VariableDeclaration>(scalarName(declaration->name, field), nullptr));
+                }
+            }
+            replaced++;
+        }
+        static_cast<VariableStatement *>(statement)->declarations = std::move(declarations);
+        return true;
+    });
+
+    ASTWalker::rewriteExpressions(body, [&](std::unique_ptr<Expression> &expression) {
+        if (isFieldAccess(expression.get(), false)) {
+            auto member = static_cast<MemberExpression *>(expression.get());
+            std::string name = scalarName(static_cast<Identifier *>(member->targetObject.get())->symbol,
+                                          static_cast<Identifier *>(member->property.get())->symbol);
+            expression = std::make_unique<Identifier>(name);
+        }
+    });
+}
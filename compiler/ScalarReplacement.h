@@ -0,0 +1,49 @@
+#ifndef BOSSCRIPT_SCALARREPLACEMENT_H
+#define BOSSCRIPT_SCALARREPLACEMENT_H
+
+#include <map>
+#include <optional>
+#include "ModelAnalyzer.h"
+#include "Pass.h"
+
+// Replaces model instances that never escape the function allocating them with one local variable per field.
+//
+//     var d = DupliBroj(a, b);      =>   var d#x = a, d#y = b;
+//     ispis(d.x * d.y);             =>   ispis(d#x * d#y);
+//
+// An instance escapes if its variable is used for anything other than reading or writing a field:
+// passed as an argument, returned, stored, reassigned, used to call a method or captured by a nested function.
+// Only field accesses after the declaration and inside the block declaring the variable are its own; any other
+// use of the name, or a second declaration of it in the function, keeps the instance allocated.
+// Only models whose constructor does nothing but copy its parameters into fields are replaced.
+// Methods are not inlined, so an instance returned by a method (suma = suma.plus(d)) is still allocated,
+// and so is its argument.
+class ScalarReplacement : public Pass {
+private:
+    // Field initialized by each constructor parameter, in parameter order
+    using ConstructorFields = std::vector<std::optional<std::string>>;
+
+    const ModelAnalyzer &models;
+    std::map<const ModelDefinitionStatement *, std::optional<ConstructorFields>> constructors;
+    size_t replaced = 0;
+
+    const std::optional<ConstructorFields> &constructorFields(const ModelDefinitionStatement *model);
+
+    void replaceInFunction(Statement *body, const std::vector<std::unique_ptr<FunctionParameter>> &params);
+
+    static std::string scalarName(const std::string &variable, const std::string &field);
+
+public:
+    explicit ScalarReplacement(const ModelAnalyzer &models) : models(models) {}
+
+    std::string name() const override {
+        return "scalar-replacement";
+    }
+
+    void run(Program &program) override;
+
+    void printStatistics(std::ostream &os) const override;
+};
+
+
+#endif //BOSSCRIPT_SCALARREPLACEMENT_H
@@ -0,0 +1,173 @@
+#include "Scheduler.h"
+#include <algorithm>
+#include <iomanip>
+
+namespace {
+    thread_local Scheduler *currentScheduler = nullptr;
+    thread_local size_t currentWorker = 0;
+}
+
+Scheduler::Scheduler(size_t workerCount) {
+    workerCount = std::max<size_t>(workerCount, 1);
+    for (size_t i = 0; i < workerCount; i++) {
+        workers.push_back(std::make_unique<Worker>(i + 1));
+    }
+    for (size_t i = 0; i < workerCount; i++) {
+        workers[i]->thread = std::thread(&Scheduler::run, this, i);
+    }
+}
+
+Scheduler::~Scheduler() {
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        finished.wait(lock, [this]() { return pending.load() == 0; });
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto &worker: workers) {
+        worker->thread.join();
+    }
+}
+
+void Scheduler::submit(Task task) {
+    auto job = new Job{std::move(task), Clock::now()};
+    if (!started.exchange(true)) {
+        firstSubmit = job->submitted;
+    }
+    pending.fetch_add(1);
+
+    if (currentScheduler == this) {
+        workers[currentWorker]->deque.push(job);
+    } else {
+        auto &worker = *workers[nextInbox.fetch_add(1, std::memory_order_relaxed) % workers.size()];
+        std::lock_guard<std::mutex> lock(worker.inboxMutex);
+        worker.inbox.push_back(job);
+    }
+
+    // Workers go to sleep only after checking queued, so either they see this job or we see them sleeping
+    queued.fetch_add(1);
+    if (sleeping.load() > 0) {
+        std::lock_guard<std::mutex> lock(mutex);
+        wake.notify_one();
+    }
+}
+
+void Scheduler::wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [this]() { return pending.load() == 0; });
+    if (error) {
+        auto thrown = error;
+        error = nullptr;
+        std::rethrow_exception(thrown);
+    }
+}
+
+void Scheduler::run(size_t index) {
+    currentScheduler = this;
+    currentWorker = index;
+    auto &worker = *workers[index];
+
+    while (true) {
+        if (auto job = next(index)) {
+            queued.fetch_sub(1);
+            complete(worker, job);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(mutex);
+        sleeping.fetch_add(1);
+        wake.wait(lock, [this]() { return queued.load() > 0 || stopping; });
+        sleeping.fetch_sub(1);
+        if (stopping) {
+            return;
+        }
+    }
+}
+
+Scheduler::Job *Scheduler::takeFromInbox(Worker &worker) {
+    std::lock_guard<std::mutex> lock(worker.inboxMutex);
+    if (worker.inbox.empty()) {
+        return nullptr;
+    }
+    auto job = worker.inbox.front();
+    worker.inbox.pop_front();
+    return job;
+}
+
+Scheduler::Job *Scheduler::next(size_t index) {
+    auto &worker = *workers[index];
+    if (auto job = worker.deque.pop()) {
+        return job;
+    }
+    if (auto job = takeFromInbox(worker)) {
+        return job;
+    }
+    if (workers.size() == 1) {
+        return nullptr;
+    }
+    for (size_t attempt = 0; attempt < workers.size(); attempt++) {
+        auto victim = worker.random() % workers.size();
+        if (victim == index) {
+            continue;
+        }
+        auto job = workers[victim]->deque.steal();
+        if (!job) {
+            job = takeFromInbox(*workers[victim]);
+        }
+        if (job) {
+            worker.stolen++;
+            return job;
+        }
+    }
+    return nullptr;
+}
+
+void Scheduler::complete(Worker &worker, Job *job) {
+    try {
+        job->task();
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!error) {
+            error = std::current_exception();
+        }
+    }
+    auto now = Clock::now();
+    worker.latencies.push_back(std::chrono::duration<double, std::milli>(now - job->submitted).count());
+    delete job;
+
+    if (pending.fetch_sub(1) == 1) {
+        std::lock_guard<std::mutex> lock(mutex);
+        lastFinish = now;
+        finished.notify_all();
+    }
+}
+
+void Scheduler::printStatistics(std::ostream &os) {
+    wait();
+
+    std::vector<double> latencies;
+    size_t stolen = 0;
+    for (const auto &worker: workers) {
+        latencies.insert(latencies.end(), worker->latencies.begin(), worker->latencies.end());
+        stolen += worker->stolen;
+    }
+    std::sort(latencies.begin(), latencies.end());
+
+    auto elapsed = std::chrono::duration<double>(lastFinish - firstSubmit).count();
+    auto percentile = [&latencies](double p) {
+        if (latencies.empty()) {
+            return 0.0;
+        }
+        auto rank = static_cast<size_t>(p * static_cast<double>(latencies.size() - 1) + 0.5);
+        return latencies[rank];
+    };
+
+    os << std::fixed << std::setprecision(2);
+    os << "Scheduler: " << latencies.size() << " tasks on " << workers.size() << " workers in "
+       << elapsed * 1000 << "ms (" << (elapsed > 0 ? static_cast<double>(latencies.size()) / elapsed : 0.0)
+       << " tasks/s), " << stolen << " stolen" << std::endl;
+    os << "Scheduler latency: p50 " << percentile(0.5) << "ms, p95 " << percentile(0.95) << "ms, p99 "
+       << percentile(0.99) << "ms, max " << percentile(1.0) << "ms" << std::endl;
+    os.unsetf(std::ios::floatfield);
+    os << std::setprecision(6);
+}
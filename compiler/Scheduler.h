@@ -0,0 +1,85 @@
+#ifndef BOSSCRIPT_SCHEDULER_H
+#define BOSSCRIPT_SCHEDULER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <random>
+#include <thread>
+#include <vector>
+#include "WorkStealingDeque.h"
+
+// Runs tasks on a fixed set of workers. Every worker has its own deque for tasks submitted from inside a task
+// it runs, and an inbox for tasks submitted from outside, which are spread over the workers round-robin.
+// An idle worker takes from its own deque first, then from its inbox, then steals from the deque or the
+// inbox of randomly chosen workers.
+class Scheduler {
+public:
+    using Task = std::function<void()>;
+    using Clock = std::chrono::steady_clock;
+
+private:
+    struct Job {
+        Task task;
+        Clock::time_point submitted;
+    };
+
+    struct Worker {
+        WorkStealingDeque<Job *> deque;
+        // Only the owner may push to the deque, so other threads submit here
+        std::mutex inboxMutex;
+        std::deque<Job *> inbox;
+        std::thread thread;
+        std::minstd_rand random;
+        std::vector<double> latencies;
+        size_t stolen = 0;
+
+        explicit Worker(size_t seed) : random(seed) {}
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<size_t> nextInbox{0};
+
+    // Jobs sitting in a deque or an inbox. It can dip below zero when a job is taken before the
+    // submitter counts it
+    std::atomic<int64_t> queued{0};
+    std::atomic<size_t> pending{0};
+    std::atomic<size_t> sleeping{0};
+    std::atomic<bool> started{false};
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable finished;
+    bool stopping = false;
+    std::exception_ptr error;
+    Clock::time_point firstSubmit;
+    Clock::time_point lastFinish;
+
+    void run(size_t index);
+
+    Job *next(size_t index);
+
+    static Job *takeFromInbox(Worker &worker);
+
+    void complete(Worker &worker, Job *job);
+
+public:
+    explicit Scheduler(size_t workerCount = std::thread::hardware_concurrency());
+
+    ~Scheduler();
+
+    void submit(Task task);
+
+    // Blocks until every submitted task has finished. Rethrows the first exception thrown by a task
+    void wait();
+
+    void printStatistics(std::ostream &os);
+};
+
+
+#endif //BOSSCRIPT_SCHEDULER_H
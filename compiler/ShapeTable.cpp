@@ -0,0 +1,51 @@
+#include "ShapeTable.h"
+#include <algorithm>
+
+std::optional<size_t> Shape::slotOf(const std::string &property) const {
+    auto slot = std::find(properties.begin(), properties.end(), property);
+    if (slot == properties.end()) {
+        return std::nullopt;
+    }
+    return slot - properties.begin();
+}
+
+ShapeTable::ShapeTable() {
+    shapes.emplace_back(emptyShape, std::nullopt, std::vector<std::string>(), false);
+    shapes.emplace_back(dictionaryShape, std::nullopt, std::vector<std::string>(), false);
+    shapes[dictionaryShape].isDictionary = true;
+}
+
+size_t ShapeTable::transition(size_t shape, const std::string &property) {
+    if (shapes[shape].isDictionary) {
+        return dictionaryShape;
+    }
+    if (shapes[shape].slotOf(property)) {
+        // Redefining an existing key keeps its slot
+        return shape;
+    }
+    auto existing = shapes[shape].transitions.find(property);
+    if (existing != shapes[shape].transitions.end()) {
+        return existing->second;
+    }
+    if (shapes[shape].properties.size() >= maxFastProperties) {
+        return dictionaryShape;
+    }
+
+    std::vector<std::string> properties = shapes[shape].properties;
+    properties.push_back(property);
+    size_t id = shapes.size();
+    shapes.emplace_back(id, shape, std::move(properties), false);
+    shapes[shape].transitions[property] = id;
+    return id;
+}
+
+size_t ShapeTable::shapeOfModel(const ModelLayout &layout) {
+    auto existing = modelShapes.find(layout.modelName);
+    if (existing != modelShapes.end()) {
+        return existing->second;
+    }
+    size_t id = shapes.size();
+    shapes.emplace_back(id, std::nullopt, layout.fields, true);
+    modelShapes[layout.modelName] = id;
+    return id;
+}
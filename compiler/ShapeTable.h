@@ -0,0 +1,59 @@
+#ifndef BOSSCRIPT_SHAPETABLE_H
+#define BOSSCRIPT_SHAPETABLE_H
+
+#include <map>
+#include <string>
+#include <vector>
+#include <optional>
+#include <unordered_map>
+#include "ModelLayout.h"
+
+// Hidden class of an object: the ordered list of its properties. Objects that get the same keys
+// in the same order share a shape, so a property's slot is a function of the shape alone.
+class Shape {
+public:
+    size_t id;
+    std::optional<size_t> parent;
+    std::vector<std::string> properties;
+    std::map<std::string, size_t> transitions;
+    bool isModel;
+    // Objects with this shape keep their properties in a PropertyDictionary instead of slots
+    bool isDictionary = false;
+
+    Shape(size_t id, std::optional<size_t> parent, std::vector<std::string> properties, bool isModel)
+            : id(id), parent(parent), properties(std::move(properties)), isModel(isModel) {}
+
+    std::optional<size_t> slotOf(const std::string &property) const;
+};
+
+class ShapeTable {
+private:
+    std::vector<Shape> shapes;
+    std::unordered_map<std::string, size_t> modelShapes;
+
+public:
+    static constexpr size_t emptyShape = 0;
+    static constexpr size_t dictionaryShape = 1;
+    // Objects that would get more properties than this switch to dictionary mode
+    static constexpr size_t maxFastProperties = 32;
+
+    ShapeTable();
+
+    // Shape reached by adding property to an object of the given shape. Past maxFastProperties this is
+    // the dictionary shape, which every later transition stays in
+    size_t transition(size_t shape, const std::string &property);
+
+    // Model instances have a fixed layout, so every model gets a single shape outside the transition tree
+    size_t shapeOfModel(const ModelLayout &layout);
+
+    const Shape &get(size_t shape) const {
+        return shapes[shape];
+    }
+
+    size_t size() const {
+        return shapes.size();
+    }
+};
+
+
+#endif //BOSSCRIPT_SHAPETABLE_H
@@ -0,0 +1,113 @@
+#include "SmallIntegers.h"
+#include "NumericValue.h"
+#include "../parser/AST/ASTWalker.h"
+
+void SmallIntegers::run(Program &program) {
+    std::set<std::string> counters;
+    visit(&program, counters);
+}
+
+void SmallIntegers::printStatistics(std::ostream &os) const {
+    os << "Small integers: " << integerLoops << " of " << countedLoops << " counted loops, "
+       << integerIndices << " integer index sites" << std::endl;
+}
+
+static std::optional<NumericValue> integerLiteral(Expression *expression) {
+    if (expression == nullptr || expression->kind != NodeType::NumericLiteral) {
+        return std::nullopt;
+    }
+    auto value = NumericValue::of(static_cast<NumericLiteral *>(expression)->value);
+    if (!value.isInteger()) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+bool SmallIntegers::hasIntegerBounds(ForStatement *loop) {
+    auto start = integerLiteral(loop->startValue.get());
+    auto end = integerLiteral(loop->endValue.get());
+    auto step = loop->step ? integerLiteral(loop->step.get()) : NumericValue::of(1);
+    if (!start || !end || !step || step->asInteger() == 0) {
+        return false;
+    }
+    // A step away from the end never reaches it, so the counter is not bounded by it
+    bool upwards = start->asInteger() < end->asInteger();
+    bool downwards = start->asInteger() > end->asInteger();
+    if ((upwards && step->asInteger() < 0) || (downwards && step->asInteger() > 0)) {
+        return false;
+    }
+    // The counter ends one step past the end, that value has to be a small integer too
+    auto last = NumericValue::apply("+", *end, *step);
+    return last && last->isInteger();
+}
+
+void SmallIntegers::visit(Statement *node, std::set<std::string> &counters) {
+    switch (node->kind) {
+        case NodeType::ForStatement: {
+            auto loop = static_cast<ForStatement *>(node);
+            if (loop->isCounted) {
+                countedLoops++;
+                loop->hasIntegerCounter = hasIntegerBounds(loop);
+                integerLoops += loop->hasIntegerCounter;
+            }
+
+            // Counted loops never rebind the counter in the body, so it can be tracked by name there.
+            // Any other loop hides an outer counter with the same name.
+            const std::string &counter = loop->counter->symbol;
+            bool outer = counters.count(counter);
+            if (loop->hasIntegerCounter) {
+                counters.insert(counter);
+            } else {
+                counters.erase(counter);
+            }
+            visit(loop->body.get(), counters);
+            if (outer) {
+                counters.insert(counter);
+            } else {
+                counters.erase(counter);
+            }
+            return;
+        }
+        case NodeType::ForEachStatement: {
+            // The element hides an outer counter with the same name
+            auto loop = static_cast<ForEachStatement *>(node);
+            visit(loop->iterable.get(), counters);
+            bool outer = counters.erase(loop->element->symbol);
+            visit(loop->body.get(), counters);
+            if (outer) {
+                counters.insert(loop->element->symbol);
+            }
+            return;
+        }
+        case NodeType::FunctionDeclaration:
+        case NodeType::FunctionExpression:
+        case NodeType::ModelDefinition: {
+            // Function bodies can run after the loop has moved on, or see a parameter with the same name
+            std::set<std::string> none;
+            ASTWalker::forEachChild(node, [this, &none](Statement *child) {
+                visit(child, none);
+            });
+            return;
+        }
+        case NodeType::MemberExpression: {
+            auto member = static_cast<MemberExpression *>(node);
+            if (!member->isComputed) {
+                break;
+            }
+            auto index = member->property.get();
+            bool isCounter = index->kind == NodeType::Identifier && counters.count(static_cast<Identifier *>(index)->symbol);
+            auto literal = integerLiteral(index);
+            if (isCounter || (literal && literal->asInteger() >= 0)) {
+                member->hasIntegerIndex = true;
+                integerIndices++;
+            }
+            break;
+        }
+        default:
+            break;
+    }
+
+    ASTWalker::forEachChild(node, [this, &counters](Statement *child) {
+        visit(child, counters);
+    });
+}
@@ -0,0 +1,31 @@
+#ifndef BOSSCRIPT_SMALLINTEGERS_H
+#define BOSSCRIPT_SMALLINTEGERS_H
+
+#include <set>
+#include "Pass.h"
+
+// Finds counted loops whose counter is a small integer on every iteration (integer start and step, a step
+// towards the end, and an end that leaves room for one more step), and array accesses indexed by such a counter or an integer literal.
+// These can use integer arithmetic, compares and indexing without converting through doubles.
+class SmallIntegers : public Pass {
+private:
+    size_t countedLoops = 0;
+    size_t integerLoops = 0;
+    size_t integerIndices = 0;
+
+    void visit(Statement *node, std::set<std::string> &counters);
+
+    static bool hasIntegerBounds(ForStatement *loop);
+
+public:
+    std::string name() const override {
+        return "small-integers";
+    }
+
+    void run(Program &program) override;
+
+    void printStatistics(std::ostream &os) const override;
+};
+
+
+#endif //BOSSCRIPT_SMALLINTEGERS_H
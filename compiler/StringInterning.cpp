@@ -0,0 +1,23 @@
+#include "StringInterning.h"
+#include "../parser/AST/ASTWalker.h"
+
+void StringInterning::run(Program &program) {
+    ASTWalker::walk(&program, [this](Statement *statement) {
+        if (statement->kind == NodeType::StringLiteral) {
+            auto string = static_cast<StringLiteral *>(statement);
+            string->internedId = strings.intern(string->value);
+            literals++;
+            literalBytes += string->value.size();
+        }
+        return true;
+    });
+}
+
+void StringInterning::printStatistics(std::ostream &os) const {
+    size_t internedBytes = 0;
+    for (size_t id = 0; id < strings.size(); id++) {
+        internedBytes += strings.get(id).value.size();
+    }
+    os << "String interning: " << strings.size() << " strings for " << literals << " literals, "
+       << internedBytes << " of " << literalBytes << " bytes kept" << std::endl;
+}
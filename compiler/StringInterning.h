@@ -0,0 +1,30 @@
+#ifndef BOSSCRIPT_STRINGINTERNING_H
+#define BOSSCRIPT_STRINGINTERNING_H
+
+#include "Pass.h"
+#include "StringTable.h"
+
+// Gives every string literal an id in the program's string table. Runs after constant folding, so
+// concatenations of literals are interned as a single string.
+class StringInterning : public Pass {
+private:
+    StringTable strings;
+    size_t literals = 0;
+    size_t literalBytes = 0;
+
+public:
+    std::string name() const override {
+        return "string-interning";
+    }
+
+    void run(Program &program) override;
+
+    void printStatistics(std::ostream &os) const override;
+
+    const StringTable &table() const {
+        return strings;
+    }
+};
+
+
+#endif //BOSSCRIPT_STRINGINTERNING_H
@@ -0,0 +1,22 @@
+#include "StringTable.h"
+
+uint64_t StringTable::hash(const std::string &value) {
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ull;
+    for (unsigned char c: value) {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+size_t StringTable::intern(const std::string &value) {
+    auto existing = ids.find(value);
+    if (existing != ids.end()) {
+        return existing->second;
+    }
+    size_t id = strings.size();
+    strings.emplace_back(id, value, hash(value));
+    ids.emplace(value, id);
+    return id;
+}
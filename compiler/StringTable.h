@@ -0,0 +1,40 @@
+#ifndef BOSSCRIPT_STRINGTABLE_H
+#define BOSSCRIPT_STRINGTABLE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+// String stored once for the whole program, with its hash computed when it is interned
+class InternedString {
+public:
+    size_t id;
+    std::string value;
+    uint64_t hash;
+
+    InternedString(size_t id, std::string value, uint64_t hash) : id(id), value(std::move(value)), hash(hash) {}
+};
+
+class StringTable {
+private:
+    std::vector<InternedString> strings;
+    std::unordered_map<std::string, size_t> ids;
+
+public:
+    static uint64_t hash(const std::string &value);
+
+    // Id of value, adding it to the table the first time it is seen
+    size_t intern(const std::string &value);
+
+    const InternedString &get(size_t id) const {
+        return strings[id];
+    }
+
+    size_t size() const {
+        return strings.size();
+    }
+};
+
+
+#endif //BOSSCRIPT_STRINGTABLE_H
@@ -0,0 +1,78 @@
+#include "TailCalls.h"
+#include "Bindings.h"
+#include "../parser/AST/ASTWalker.h"
+
+void TailCalls::run(Program &program) {
+    assignedNames = Bindings::assignedNames(&program);
+    visit(&program, nullptr, false, false);
+}
+
+void TailCalls::printStatistics(std::ostream &os) const {
+    os << "Tail calls: " << tailCalls << " (" << selfTailCalls << " self-recursive)" << std::endl;
+}
+
+void TailCalls::visit(Statement *node, FunctionDeclaration *function, bool selfVisible, bool protectedRegion) {
+    switch (node->kind) {
+        case NodeType::FunctionDeclaration: {
+            // The name only refers to the function itself if the body does not rebind it
+            auto declaration = static_cast<FunctionDeclaration *>(node);
+            const std::string &name = declaration->name->symbol;
+            bool visible = !assignedNames.count(name) && !Bindings::boundNames(declaration->body.get()).count(name);
+            for (const auto &param: declaration->params) {
+                visible = visible && param->identifier->symbol != name;
+            }
+            visit(declaration->body.get(), declaration, visible, false);
+            return;
+        }
+        case NodeType::FunctionExpression:
+            visit(static_cast<FunctionExpression *>(node)->body.get(), nullptr, false, false);
+            return;
+        case NodeType::ModelDefinition: {
+            // A bare method name inside a model does not refer to the method, methods are only reached through @
+            auto model = static_cast<ModelDefinitionStatement *>(node);
+            visit(model->constructor->body.get(), model->constructor.get(), false, false);
+            for (auto block: {model->privateBlock.get(), model->publicBlock.get()}) {
+                if (!block) continue;
+                for (const auto &member: block->getBody()) {
+                    if (member->kind == NodeType::FunctionDeclaration) {
+                        auto method = static_cast<FunctionDeclaration *>(member.get());
+                        visit(method->body.get(), method, false, false);
+                    } else {
+                        visit(member.get(), nullptr, false, false);
+                    }
+                }
+            }
+            return;
+        }
+        case NodeType::TryCatch: {
+            auto tryCatch = static_cast<TryCatchStatement *>(node);
+            visit(tryCatch->tryBlock.get(), function, selfVisible, true);
+            visit(tryCatch->catchBlock.get(), function, selfVisible, protectedRegion || tryCatch->finallyBlock);
+            if (tryCatch->finallyBlock) {
+                visit(tryCatch->finallyBlock.get(), function, selfVisible, protectedRegion);
+            }
+            return;
+        }
+        case NodeType::ReturnStatement: {
+            auto returnStatement = static_cast<ReturnStatement *>(node);
+            auto call = dynamic_cast<CallExpression *>(returnStatement->argument.get());
+            if (!call || protectedRegion) {
+                break;
+            }
+            returnStatement->isTailCall = true;
+            tailCalls++;
+            if (function && selfVisible && call->callee->kind == NodeType::Identifier
+                && static_cast<Identifier *>(call->callee.get())->symbol == function->name->symbol) {
+                returnStatement->isSelfTailCall = true;
+                selfTailCalls++;
+            }
+            break;
+        }
+        default:
+            break;
+    }
+
+    ASTWalker::forEachChild(node, [&](Statement *child) {
+        visit(child, function, selfVisible, protectedRegion);
+    });
+}
@@ -0,0 +1,32 @@
+#ifndef BOSSCRIPT_TAILCALLS_H
+#define BOSSCRIPT_TAILCALLS_H
+
+#include <set>
+#include "Pass.h"
+
+// Marks 'vrati f(...)' statements whose call can replace the current frame instead of pushing a new one.
+// A return is not a tail call when this frame still has work after the call: inside a probaj block, whose
+// spasi handler has to catch what the call throws, or inside a spasi block of a statement with a svakako
+// block. Calls of the enclosing function itself are marked separately, since they can become a jump. Model
+// methods never are: their bare name inside the model refers to a global, not the method.
+class TailCalls : public Pass {
+private:
+    // A function whose name is assigned somewhere may not be the one its name refers to in its own body
+    std::set<std::string> assignedNames;
+    size_t tailCalls = 0;
+    size_t selfTailCalls = 0;
+
+    void visit(Statement *node, FunctionDeclaration *function, bool selfVisible, bool protectedRegion);
+
+public:
+    std::string name() const override {
+        return "tail-calls";
+    }
+
+    void run(Program &program) override;
+
+    void printStatistics(std::ostream &os) const override;
+};
+
+
+#endif //BOSSCRIPT_TAILCALLS_H
@@ -0,0 +1,106 @@
+#ifndef BOSSCRIPT_VALUE_H
+#define BOSSCRIPT_VALUE_H
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include "NumericValue.h"
+
+// NaN-boxed script value in 64 bits. Numbers that are not small integers are stored as the double itself.
+// Every other value sits in the low 48 bits of a quiet NaN with the sign bit set, tagged in bits 48-50:
+// small integers (see NumericValue) as a 32-bit payload, booleans and strings. Arithmetic only ever stores
+// the canonical positive NaN, so a double can never be mistaken for a boxed value.
+class Value {
+private:
+    static constexpr uint64_t boxed = 0xFFF8000000000000;
+    static constexpr uint64_t tagMask = 0x0007000000000000;
+    static constexpr uint64_t payloadMask = 0x0000FFFFFFFFFFFF;
+    static constexpr uint64_t canonicalNaN = 0x7FF8000000000000;
+
+    enum Tag : uint64_t {
+        UndefinedTag = 1ull << 48,
+        BooleanTag = 2ull << 48,
+        StringTag = 3ull << 48,
+        IntegerTag = 4ull << 48
+    };
+
+    uint64_t bits;
+
+    explicit Value(uint64_t bits) : bits(bits) {}
+
+public:
+    Value() : bits(boxed | UndefinedTag) {}
+
+    // Integral values that fit are stored as small integers, so every number has exactly one representation
+    static Value number(double value) {
+        if (std::isnan(value)) {
+            return Value(canonicalNaN);
+        }
+        auto numeric = NumericValue::of(value);
+        if (numeric.isInteger()) {
+            return integer(numeric.asInteger());
+        }
+        uint64_t raw;
+        std::memcpy(&raw, &value, sizeof(raw));
+        return Value(raw);
+    }
+
+    static Value integer(int32_t value) {
+        return Value(boxed | IntegerTag | static_cast<uint32_t>(value));
+    }
+
+    static Value boolean(bool value) {
+        return Value(boxed | BooleanTag | static_cast<uint64_t>(value));
+    }
+
+    // The string is not owned, it has to outlive the value (strings from the StringTable do)
+    static Value string(const std::string *value) {
+        return Value(boxed | StringTag | reinterpret_cast<uintptr_t>(value));
+    }
+
+    bool isInteger() const {
+        return (bits & (boxed | tagMask)) == (boxed | IntegerTag);
+    }
+
+    // Small integers included
+    bool isNumber() const {
+        return (bits & boxed) != boxed || isInteger();
+    }
+
+    bool isBoolean() const {
+        return (bits & (boxed | tagMask)) == (boxed | BooleanTag);
+    }
+
+    bool isString() const {
+        return (bits & (boxed | tagMask)) == (boxed | StringTag);
+    }
+
+    bool isUndefined() const {
+        return bits == (boxed | UndefinedTag);
+    }
+
+    int32_t asInteger() const {
+        return static_cast<int32_t>(static_cast<uint32_t>(bits));
+    }
+
+    double asNumber() const {
+        if (isInteger()) {
+            return asInteger();
+        }
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    bool asBoolean() const {
+        return bits & 1;
+    }
+
+    const std::string *asString() const {
+        return reinterpret_cast<const std::string *>(static_cast<uintptr_t>(bits & payloadMask));
+    }
+};
+
+
+#endif //BOSSCRIPT_VALUE_H
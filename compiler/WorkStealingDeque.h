@@ -0,0 +1,110 @@
+#ifndef BOSSCRIPT_WORKSTEALINGDEQUE_H
+#define BOSSCRIPT_WORKSTEALINGDEQUE_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Chase-Lev deque (with the memory orderings from Le et al., "Correct and Efficient Work-Stealing for Weak
+// Memory Models"). The owning worker pushes and pops at the bottom, other workers steal from the top.
+// T must be a pointer, nullptr means the deque was empty or the steal lost a race.
+template<typename T>
+class WorkStealingDeque {
+private:
+    struct Buffer {
+        int64_t capacity;
+        std::unique_ptr<std::atomic<T>[]> items;
+
+        explicit Buffer(int64_t capacity) : capacity(capacity), items(new std::atomic<T>[capacity]) {}
+
+        T get(int64_t index) const {
+            return items[index & (capacity - 1)].load(std::memory_order_relaxed);
+        }
+
+        void put(int64_t index, T item) {
+            items[index & (capacity - 1)].store(item, std::memory_order_relaxed);
+        }
+    };
+
+    alignas(64) std::atomic<int64_t> top{0};
+    alignas(64) std::atomic<int64_t> bottom{0};
+    std::atomic<Buffer *> buffer;
+    // A thief may still be reading a buffer that was replaced, so old buffers live as long as the deque
+    std::vector<std::unique_ptr<Buffer>> buffers;
+
+    Buffer *grow(Buffer *old, int64_t from, int64_t to) {
+        auto bigger = std::make_unique<Buffer>(old->capacity * 2);
+        for (auto i = from; i < to; i++) {
+            bigger->put(i, old->get(i));
+        }
+        auto result = bigger.get();
+        buffers.push_back(std::move(bigger));
+        buffer.store(result, std::memory_order_release);
+        return result;
+    }
+
+public:
+    explicit WorkStealingDeque(int64_t capacity = 256) {
+        buffers.push_back(std::make_unique<Buffer>(capacity));
+        buffer.store(buffers.back().get(), std::memory_order_relaxed);
+    }
+
+    // Owner only
+    void push(T item) {
+        auto b = bottom.load(std::memory_order_relaxed);
+        auto t = top.load(std::memory_order_acquire);
+        auto a = buffer.load(std::memory_order_relaxed);
+        if (b - t > a->capacity - 1) {
+            a = grow(a, t, b);
+        }
+        a->put(b, item);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom.store(b + 1, std::memory_order_relaxed);
+    }
+
+    // Owner only
+    T pop() {
+        auto b = bottom.load(std::memory_order_relaxed) - 1;
+        auto a = buffer.load(std::memory_order_relaxed);
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto t = top.load(std::memory_order_relaxed);
+
+        if (t > b) {
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        auto item = a->get(b);
+        if (t == b) {
+            // Last item, a thief may be taking it at the same time
+            if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                item = nullptr;
+            }
+            bottom.store(b + 1, std::memory_order_relaxed);
+        }
+        return item;
+    }
+
+    // Any thread
+    T steal() {
+        auto t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto b = bottom.load(std::memory_order_acquire);
+        if (t >= b) {
+            return nullptr;
+        }
+        auto item = buffer.load(std::memory_order_acquire)->get(t);
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return nullptr;
+        }
+        return item;
+    }
+
+    bool empty() const {
+        return bottom.load(std::memory_order_relaxed) <= top.load(std::memory_order_relaxed);
+    }
+};
+
+
+#endif //BOSSCRIPT_WORKSTEALINGDEQUE_H
@@ -3,29 +3,140 @@
 #include <stdexcept>
 #include "lexer/Lexer.h"
 #include "parser/Parser.h"
+#include "compiler/Compiler.h"
+#include "Benchmarks.h"
 
 #include <chrono>
 using namespace std::chrono;
 
 int main(int argc, char* argv[]) {
-    if (argc != 2) {
-        std::cerr << "Usage: " << argv[0] << " <filename>" << std::endl;
+    std::string filename;
+    std::vector<std::string> jobFiles;
+    bool debugInlineCaches = false;
+    bool printStats = false;
+    bool dumpAst = false;
+    int threads = 0;
+    int jobs = 0;
+    int repeat = 100;
+    int pipelineMegabytes = 0;
+    int reads = 0;
+    int bindCalls = 0;
+    int dictionaryKeys = 0;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--debug-ic") {
+            debugInlineCaches = true;
+        }
+        else if (arg == "--stats") {
+            printStats = true;
+        }
+        else if (arg == "--dump-ast") {
+            dumpAst = true;
+        }
+        else if (arg == "--threads" && i + 1 < argc) {
+            threads = std::stoi(argv[++i]);
+        }
+        else if (arg == "--jobs" && i + 1 < argc) {
+            jobs = std::stoi(argv[++i]);
+        }
+        else if (arg == "--repeat" && i + 1 < argc) {
+            repeat = std::stoi(argv[++i]);
+        }
+        else if (arg == "--pipeline" && i + 1 < argc) {
+            pipelineMegabytes = std::stoi(argv[++i]);
+        }
+        else if (arg == "--read" && i + 1 < argc) {
+            reads = std::stoi(argv[++i]);
+        }
+        else if (arg == "--bind" && i + 1 < argc) {
+            bindCalls = std::stoi(argv[++i]);
+        }
+        else if (arg == "--dict" && i + 1 < argc) {
+            dictionaryKeys = std::stoi(argv[++i]);
+        }
+        else if (filename.empty()) {
+            filename = arg;
+        }
+        else if (jobs > 0 || reads > 0) {
+            jobFiles.push_back(arg);
+        }
+        else {
+            filename.clear();
+            break;
+        }
+    }
+
+    if (pipelineMegabytes > 0) {
+        return runPipelineBenchmark(pipelineMegabytes);
+    }
+    if (bindCalls > 0) {
+        return runBindBenchmark(bindCalls);
+    }
+    if (dictionaryKeys > 0) {
+        return runDictionaryBenchmark(dictionaryKeys);
+    }
+
+    if (filename.empty()) {
+        std::cerr << "Usage: " << argv[0] << " <filename> [--stats] [--debug-ic] [--dump-ast] [--threads N]" << std::endl;
+        std::cerr << "       " << argv[0] << " --jobs N [--repeat K] <filename>..." << std::endl;
+        std::cerr << "       " << argv[0] << " --pipeline MB" << std::endl;
+        std::cerr << "       " << argv[0] << " --read N <filename>..." << std::endl;
+        std::cerr << "       " << argv[0] << " --bind N" << std::endl;
+        std::cerr << "       " << argv[0] << " --dict N" << std::endl;
         return 1;
     }
 
-    std::string filename = argv[1];
+    jobFiles.insert(jobFiles.begin(), filename);
+    try {
+        if (reads > 0) {
+            return runReadBenchmark(reads, jobFiles);
+        }
+        if (jobs > 0) {
+            return runJobsBenchmark(jobs, repeat, jobFiles);
+        }
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
 
     std::ifstream file(filename);
 
     if(file){
         std::string src((std::istreambuf_iterator<char>(file)),std::istreambuf_iterator<char>());
 
+        if (threads > 0) {
+            try {
+                return runThreadsBenchmark(src, threads, printStats);
+            } catch (const std::exception &e) {
+                std::cerr << e.what() << std::endl;
+                return 1;
+            }
+        }
+
         auto start = high_resolution_clock::now();
         Parser p(false);
         auto program = p.parseProgram(src);
         auto stop = high_resolution_clock::now();
         auto duration = duration_cast<milliseconds>(stop - start);
         std::cout << "Program parsed in " << duration.count() << "ms" << std::endl;
+
+        Compiler compiler;
+        if (dumpAst) {
+            compiler.dumpPasses(std::cout);
+        }
+        start = high_resolution_clock::now();
+        compiler.compile(program);
+        stop = high_resolution_clock::now();
+        duration = duration_cast<milliseconds>(stop - start);
+        std::cout << "Program compiled in " << duration.count() << "ms" << std::endl;
+
+        if (printStats) {
+            compiler.printStatistics(std::cout);
+        }
+        else if (debugInlineCaches) {
+            compiler.pass("inline-caches")->printStatistics(std::cout);
+        }
     }
     else {
         std::cout << "Failed to open file " << filename << std::endl;
@@ -0,0 +1,447 @@
+#include "ASTPrinter.h"
+#include <charconv>
+#include <cmath>
+
+std::string ASTPrinter::print(Statement *node) {
+    ASTPrinter printer;
+    if (node->kind == NodeType::Program) {
+        for (const auto &statement: static_cast<Program *>(node)->body) {
+            printer.printStatement(statement.get());
+            printer.out << "\n";
+        }
+    }
+    else {
+        printer.printStatement(node);
+        printer.out << "\n";
+    }
+    return printer.out.str();
+}
+
+void ASTPrinter::indent() {
+    out << std::string(depth * 4, ' ');
+}
+
+void ASTPrinter::printBlock(const std::vector<std::unique_ptr<Statement>> &body) {
+    out << "{\n";
+    depth++;
+    for (const auto &statement: body) {
+        indent();
+        printStatement(statement.get());
+        out << "\n";
+    }
+    depth--;
+    indent();
+    out << "}";
+}
+
+void ASTPrinter::printParams(const std::vector<std::unique_ptr<FunctionParameter>> &params) {
+    out << "(";
+    for (size_t i = 0; i < params.size(); i++) {
+        if (i > 0) out << ", ";
+        out << params[i]->identifier->symbol << (params[i]->inCell ? "/*cell*/" : "");
+        if (params[i]->typeAnnotation) {
+            out << ": ";
+            printTypeAnnotation(params[i]->typeAnnotation.get());
+        }
+    }
+    out << ")";
+}
+
+void ASTPrinter::printTypeAnnotation(TypeAnnotation *type) {
+    out << type->typeName << (type->isArrayType ? "[]" : "");
+}
+
+void ASTPrinter::printNumber(double value) {
+    // The lexer has no exponent notation, so numbers are always printed in fixed form
+    char buffer[512];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::fixed);
+    out << std::string(buffer, result.ptr);
+}
+
+void ASTPrinter::printSafepoint(size_t cost) {
+    if (cost > 0) {
+        out << "/*safepoint " << cost << "*/ ";
+    }
+}
+
+void ASTPrinter::printCaptures(const std::vector<CapturedVariable> &captures) {
+    if (captures.empty()) {
+        return;
+    }
+    out << "/*captures ";
+    for (size_t i = 0; i < captures.size(); i++) {
+        out << (i > 0 ? ", " : "") << (captures[i].byValue ? "" : "&") << captures[i].name;
+    }
+    out << "*/ ";
+}
+
+void ASTPrinter::printElementKind(ElementKind kind) {
+    switch (kind) {
+        case ElementKind::SmallInt: out << "/*smi*/"; break;
+        case ElementKind::Double: out << "/*double*/"; break;
+        case ElementKind::Generic: out << "/*generic*/"; break;
+    }
+}
+
+void ASTPrinter::printAssignment(AssignmentExpression *assignment) {
+    printExpression(assignment->assignee.get());
+    out << " " << assignment->assignmentOperator << " ";
+    printExpression(assignment->value.get());
+}
+
+void ASTPrinter::printStatement(Statement *statement) {
+    // An assignment is only left unparenthesized where it is a statement of its own
+    if (statement->kind == NodeType::AssignmentExpression) {
+        printAssignment(static_cast<AssignmentExpression *>(statement));
+        out << ";";
+        return;
+    }
+    if (auto expression = dynamic_cast<Expression *>(statement)) {
+        printExpression(expression);
+        if (statement->kind != NodeType::FunctionExpression) out << ";";
+        return;
+    }
+
+    switch (statement->kind) {
+        case NodeType::Block:
+            printBlock(static_cast<BlockStatement *>(statement)->body);
+            break;
+        case NodeType::EmptyStatement:
+            out << ";";
+            break;
+        case NodeType::BreakStatement:
+            out << "prekid";
+            break;
+        case NodeType::VariableStatement: {
+            auto variables = static_cast<VariableStatement *>(statement);
+            out << (variables->isConstant ? "konst " : "var ");
+            for (size_t i = 0; i < variables->declarations.size(); i++) {
+                if (i > 0) out << ", ";
+                out << variables->declarations[i]->name << (variables->declarations[i]->inCell ? "/*cell*/" : "");
+                if (variables->declarations[i]->value) {
+                    out << " = ";
+                    printExpression(variables->declarations[i]->value.get());
+                }
+            }
+            out << ";";
+            break;
+        }
+        case NodeType::IfStatement: {
+            auto ifStatement = static_cast<IfStatement *>(statement);
+            out << "ako (";
+            printExpression(ifStatement->condition.get());
+            out << ") ";
+            printStatement(ifStatement->consequent.get());
+            if (ifStatement->alternate) {
+                out << (ifStatement->alternate->kind == NodeType::IfStatement ? " ili " : " inace ");
+                printStatement(ifStatement->alternate.get());
+            }
+            break;
+        }
+        case NodeType::UnlessStatement: {
+            auto unless = static_cast<UnlessStatement *>(statement);
+            out << "osim ako (";
+            printExpression(unless->condition.get());
+            out << ") ";
+            printStatement(unless->consequent.get());
+            if (unless->alternate) {
+                out << " inace ";
+                printStatement(unless->alternate.get());
+            }
+            break;
+        }
+        case NodeType::WhileStatement: {
+            auto loop = static_cast<WhileStatement *>(statement);
+            out << "dok ";
+            printSafepoint(loop->safepointCost);
+            out << "(";
+            printExpression(loop->condition.get());
+            out << ") ";
+            printBlock(loop->body->body);
+            break;
+        }
+        case NodeType::DoWhileStatement: {
+            auto loop = static_cast<DoWhileStatement *>(statement);
+            out << "radi ";
+            printSafepoint(loop->safepointCost);
+            printBlock(loop->body->body);
+            out << " dok (";
+            printExpression(loop->condition.get());
+            out << ");";
+            break;
+        }
+        case NodeType::ForStatement: {
+            auto loop = static_cast<ForStatement *>(statement);
+            out << "za svako ";
+            printSafepoint(loop->safepointCost);
+            out << (loop->isCounted ? "/*counted*/ " : "") << (loop->hasIntegerCounter ? "/*int*/ " : "") << "(" << loop->counter->symbol << (loop->counterInCell ? "/*cell*/" : "") << " od ";
+            printExpression(loop->startValue.get());
+            out << " do ";
+            printExpression(loop->endValue.get());
+            if (loop->step) {
+                out << " korak ";
+                printExpression(loop->step.get());
+            }
+            out << ") ";
+            printBlock(loop->body->body);
+            break;
+        }
+        case NodeType::ForEachStatement: {
+            auto loop = static_cast<ForEachStatement *>(statement);
+            out << "za svako ";
+            printSafepoint(loop->safepointCost);
+            if (loop->isParallel) {
+                out << "/*parallel";
+                for (size_t i = 0; i < loop->reductions.size(); i++) {
+                    out << (i == 0 ? ", reduce " : ", ") << loop->reductions[i];
+                }
+                out << "*/ ";
+            }
+            out << "(" << loop->element->symbol << (loop->elementInCell ? "/*cell*/" : "");
+            if (loop->elementKind) printElementKind(*loop->elementKind);
+            out << " od ";
+            printExpression(loop->iterable.get());
+            out << ") ";
+            printBlock(loop->body->body);
+            break;
+        }
+        case NodeType::FunctionDeclaration: {
+            auto function = static_cast<FunctionDeclaration *>(statement);
+            out << "funkcija " << function->name->symbol << (function->nameInCell ? "/*cell*/" : "");
+            printParams(function->params);
+            if (function->returnType) {
+                out << ": ";
+                printTypeAnnotation(function->returnType.get());
+            }
+            out << " ";
+            printSafepoint(function->safepointCost);
+            printCaptures(function->captures);
+            printBlock(function->body->body);
+            break;
+        }
+        case NodeType::ReturnStatement: {
+            auto returnStatement = static_cast<ReturnStatement *>(statement);
+            out << "vrati " << (returnStatement->isSelfTailCall ? "/*self tail*/ " : returnStatement->isTailCall ? "/*tail*/ " : "");
+            if (returnStatement->argument) {
+                printExpression(returnStatement->argument.get());
+            } else {
+                out << "se";
+            }
+            out << ";";
+            break;
+        }
+        case NodeType::TypeDefinition: {
+            auto type = static_cast<TypeDefinitionStatement *>(statement);
+            out << "tip " << type->name->symbol;
+            if (type->parentTypeName) out << " < " << type->parentTypeName->symbol;
+            out << " {\n";
+            depth++;
+            for (const auto &property: type->properties) {
+                indent();
+                out << property->name << ": ";
+                printTypeAnnotation(property->type.get());
+                out << ";\n";
+            }
+            depth--;
+            indent();
+            out << "}";
+            break;
+        }
+        case NodeType::ImportStatement: {
+            auto import = static_cast<ImportStatement *>(statement);
+            out << "paket \"" << import->packageName << "\"";
+            if (!import->imports.empty()) {
+                out << " {";
+                for (size_t i = 0; i < import->imports.size(); i++) {
+                    out << (i > 0 ? ", " : "") << import->imports[i]->symbol;
+                }
+                out << "}";
+            }
+            out << ";";
+            break;
+        }
+        case NodeType::TryCatch: {
+            auto tryCatch = static_cast<TryCatchStatement *>(statement);
+            out << "probaj ";
+            printBlock(tryCatch->tryBlock->body);
+            out << " spasi ";
+            printBlock(tryCatch->catchBlock->body);
+            if (tryCatch->finallyBlock) {
+                out << " svakako ";
+                printBlock(tryCatch->finallyBlock->body);
+            }
+            break;
+        }
+        case NodeType::ModelDefinition: {
+            auto model = static_cast<ModelDefinitionStatement *>(statement);
+            out << "model " << model->className->symbol << (model->nameInCell ? "/*cell*/" : "");
+            if (model->parentClassName) out << " < " << model->parentClassName->symbol;
+            out << " {\n";
+            depth++;
+            indent();
+            out << "konstruktor";
+            printParams(model->constructor->params);
+            out << " ";
+            printSafepoint(model->constructor->safepointCost);
+            printCaptures(model->constructor->captures);
+            printBlock(model->constructor->body->body);
+            out << "\n";
+            for (auto [name, block]: {std::pair{"privatno", model->privateBlock.get()}, std::pair{"javno", model->publicBlock.get()}}) {
+                if (!block) continue;
+                indent();
+                out << name << " ";
+                printBlock(block->getBody());
+                out << "\n";
+            }
+            depth--;
+            indent();
+            out << "}";
+            break;
+        }
+        default:
+            out << statement->toString();
+            break;
+    }
+}
+
+void ASTPrinter::printExpression(Expression *expression) {
+    switch (expression->kind) {
+        case NodeType::Identifier:
+            out << static_cast<Identifier *>(expression)->symbol;
+            break;
+        case NodeType::NumericLiteral:
+            printNumber(static_cast<NumericLiteral *>(expression)->value);
+            break;
+        case NodeType::StringLiteral: {
+            auto string = static_cast<StringLiteral *>(expression);
+            if (string->internedId) out << "/*str " << *string->internedId << "*/";
+            out << "\"";
+            for (char c: string->value) {
+                switch (c) {
+                    case '\n': out << "\\n"; break;
+                    case '\t': out << "\\t"; break;
+                    case '\r': out << "\\r"; break;
+                    case '\\': out << "\\\\"; break;
+                    case '"': out << "\\\""; break;
+                    default: out << c;
+                }
+            }
+            out << "\"";
+            break;
+        }
+        case NodeType::BooleanLiteral:
+            out << (static_cast<BooleanLiteral *>(expression)->value ? "tacno" : "netacno");
+            break;
+        case NodeType::NullLiteral:
+            out << "nedefinisano";
+            break;
+        case NodeType::Javascript:
+            out << "`" << static_cast<JavascriptSnippet *>(expression)->code << "`";
+            break;
+        case NodeType::BinaryExpression: {
+            auto binary = static_cast<BinaryExpression *>(expression);
+            out << "(";
+            printExpression(binary->left.get());
+            out << " " << binary->mOperator << " ";
+            printExpression(binary->right.get());
+            out << ")";
+            break;
+        }
+        case NodeType::LogicalExpression: {
+            auto logical = static_cast<LogicalExpression *>(expression);
+            out << "(";
+            printExpression(logical->left.get());
+            out << " " << logical->mOperator << " ";
+            printExpression(logical->right.get());
+            out << ")";
+            break;
+        }
+        case NodeType::UnaryExpression: {
+            auto unary = static_cast<UnaryExpression *>(expression);
+            // -(-x) printed as --x would read back as a decrement
+            auto operand = unary->operand.get();
+            bool parenthesize = operand->kind == NodeType::UnaryExpression
+                                || (operand->kind == NodeType::NumericLiteral && std::signbit(static_cast<NumericLiteral *>(operand)->value));
+            out << unary->mOperator << (parenthesize ? "(" : "");
+            printExpression(operand);
+            out << (parenthesize ? ")" : "");
+            break;
+        }
+        case NodeType::AssignmentExpression:
+            out << "(";
+            printAssignment(static_cast<AssignmentExpression *>(expression));
+            out << ")";
+            break;
+        case NodeType::MemberExpression: {
+            auto member = static_cast<MemberExpression *>(expression);
+            bool isThis = member->targetObject->kind == NodeType::Identifier
+                          && static_cast<Identifier *>(member->targetObject.get())->symbol == "@";
+            printExpression(member->targetObject.get());
+            if (member->isComputed) {
+                out << "[";
+                printExpression(member->property.get());
+                out << "]" << (member->hasIntegerIndex ? "/*int*/" : "");
+                if (member->elementKind) printElementKind(*member->elementKind);
+            } else {
+                out << (isThis ? "" : ".") << static_cast<Identifier *>(member->property.get())->symbol;
+            }
+            if (member->slot) out << "/*slot " << *member->slot << "*/";
+            if (member->methodIndex) out << "/*method " << *member->methodIndex << "*/";
+            break;
+        }
+        case NodeType::CallExpression: {
+            auto call = static_cast<CallExpression *>(expression);
+            if (call->inArena) out << "/*arena*/";
+            printExpression(call->callee.get());
+            out << "(";
+            for (size_t i = 0; i < call->args.size(); i++) {
+                if (i > 0) out << ", ";
+                printExpression(call->args[i].get());
+            }
+            out << ")";
+            break;
+        }
+        case NodeType::Object: {
+            auto object = static_cast<ObjectLiteral *>(expression);
+            if (object->inArena) out << "/*arena*/";
+            if (object->shape) out << "/*shape " << *object->shape << "*/";
+            out << "{";
+            for (size_t i = 0; i < object->properties.size(); i++) {
+                if (i > 0) out << ", ";
+                out << object->properties[i]->key << ": ";
+                printExpression(object->properties[i]->value.get());
+            }
+            out << "}";
+            break;
+        }
+        case NodeType::ArrayLiteral: {
+            auto array = static_cast<ArrayLiteral *>(expression);
+            if (array->inArena) out << "/*arena*/";
+            if (array->elementKind) printElementKind(*array->elementKind);
+            out << "[";
+            for (size_t i = 0; i < array->arr.size(); i++) {
+                if (i > 0) out << ", ";
+                printExpression(array->arr[i].get());
+            }
+            out << "]";
+            break;
+        }
+        case NodeType::FunctionExpression: {
+            auto function = static_cast<FunctionExpression *>(expression);
+            out << "funkcija";
+            printParams(function->params);
+            if (function->returnType) {
+                out << ": ";
+                printTypeAnnotation(function->returnType.get());
+            }
+            out << " ";
+            printSafepoint(function->safepointCost);
+            printCaptures(function->captures);
+            printBlock(function->body->body);
+            break;
+        }
+        default:
+            out << expression->toString();
+            break;
+    }
+}
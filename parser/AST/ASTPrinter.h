@@ -0,0 +1,43 @@
+#ifndef BOSSCRIPT_ASTPRINTER_H
+#define BOSSCRIPT_ASTPRINTER_H
+
+#include <string>
+#include <sstream>
+#include "Statements.h"
+
+// Prints an AST back as Bosscript source, with results of compiler passes (slots, method indices, counted loops,
+// integer counters, shapes, arena allocations, interned strings, element kinds,
+// closure captures and cells, tail calls, parallel loops, safepoints) added as /* comments */
+class ASTPrinter {
+private:
+    std::stringstream out;
+    size_t depth = 0;
+
+    void indent();
+
+    void printStatement(Statement *statement);
+
+    void printBlock(const std::vector<std::unique_ptr<Statement>> &body);
+
+    void printExpression(Expression *expression);
+
+    void printAssignment(AssignmentExpression *assignment);
+
+    void printParams(const std::vector<std::unique_ptr<FunctionParameter>> &params);
+
+    void printTypeAnnotation(TypeAnnotation *type);
+
+    void printNumber(double value);
+
+    void printElementKind(ElementKind kind);
+
+    void printCaptures(const std::vector<CapturedVariable> &captures);
+
+    void printSafepoint(size_t cost);
+
+public:
+    static std::string print(Statement *node);
+};
+
+
+#endif //BOSSCRIPT_ASTPRINTER_H
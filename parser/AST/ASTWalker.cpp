@@ -0,0 +1,300 @@
+#include "ASTWalker.h"
+
+void ASTWalker::forEachChild(Statement *node, const std::function<void(Statement *)> &visit) {
+    auto child = [&visit](Statement *statement) {
+        if (statement != nullptr) {
+            visit(statement);
+        }
+    };
+
+    switch (node->kind) {
+        case NodeType::Program:
+            for (const auto &statement: static_cast<Program *>(node)->body) child(statement.get());
+            break;
+        case NodeType::Block:
+            for (const auto &statement: static_cast<BlockStatement *>(node)->body) child(statement.get());
+            break;
+        case NodeType::VariableStatement:
+            for (const auto &declaration: static_cast<VariableStatement *>(node)->declarations) child(declaration.get());
+            break;
+        case NodeType::VariableDeclaration:
+            child(static_cast<VariableDeclaration *>(node)->value.get());
+            break;
+        case NodeType::BinaryExpression: {
+            auto expression = static_cast<BinaryExpression *>(node);
+            child(expression->left.get());
+            child(expression->right.get());
+            break;
+        }
+        case NodeType::LogicalExpression: {
+            auto expression = static_cast<LogicalExpression *>(node);
+            child(expression->left.get());
+            child(expression->right.get());
+            break;
+        }
+        case NodeType::UnaryExpression:
+            child(static_cast<UnaryExpression *>(node)->operand.get());
+            break;
+        case NodeType::AssignmentExpression: {
+            auto expression = static_cast<AssignmentExpression *>(node);
+            child(expression->assignee.get());
+            child(expression->value.get());
+            break;
+        }
+        case NodeType::MemberExpression: {
+            auto expression = static_cast<MemberExpression *>(node);
+            child(expression->targetObject.get());
+            child(expression->property.get());
+            break;
+        }
+        case NodeType::CallExpression: {
+            auto expression = static_cast<CallExpression *>(node);
+            child(expression->callee.get());
+            for (const auto &arg: expression->args) child(arg.get());
+            break;
+        }
+        case NodeType::Object:
+            for (const auto &property: static_cast<ObjectLiteral *>(node)->properties) child(property.get());
+            break;
+        case NodeType::ObjectProperty:
+            child(static_cast<ObjectProperty *>(node)->value.get());
+            break;
+        case NodeType::ArrayLiteral:
+            for (const auto &element: static_cast<ArrayLiteral *>(node)->arr) child(element.get());
+            break;
+        case NodeType::IfStatement: {
+            auto statement = static_cast<IfStatement *>(node);
+            child(statement->condition.get());
+            child(statement->consequent.get());
+            child(statement->alternate.get());
+            break;
+        }
+        case NodeType::UnlessStatement: {
+            auto statement = static_cast<UnlessStatement *>(node);
+            child(statement->condition.get());
+            child(statement->consequent.get());
+            child(statement->alternate.get());
+            break;
+        }
+        case NodeType::WhileStatement: {
+            auto statement = static_cast<WhileStatement *>(node);
+            child(statement->condition.get());
+            child(statement->body.get());
+            break;
+        }
+        case NodeType::DoWhileStatement: {
+            auto statement = static_cast<DoWhileStatement *>(node);
+            child(statement->body.get());
+            child(statement->condition.get());
+            break;
+        }
+        case NodeType::ForStatement: {
+            auto statement = static_cast<ForStatement *>(node);
+            child(statement->counter.get());
+            child(statement->startValue.get());
+            child(statement->endValue.get());
+            child(statement->step.get());
+            child(statement->body.get());
+            break;
+        }
+        case NodeType::ForEachStatement: {
+            auto statement = static_cast<ForEachStatement *>(node);
+            child(statement->element.get());
+            child(statement->iterable.get());
+            child(statement->body.get());
+            break;
+        }
+        case NodeType::FunctionDeclaration: {
+            auto declaration = static_cast<FunctionDeclaration *>(node);
+            for (const auto &param: declaration->params) child(param.get());
+            child(declaration->body.get());
+            break;
+        }
+        case NodeType::FunctionExpression: {
+            auto expression = static_cast<FunctionExpression *>(node);
+            for (const auto &param: expression->params) child(param.get());
+            child(expression->body.get());
+            break;
+        }
+        case NodeType::ReturnStatement:
+            child(static_cast<ReturnStatement *>(node)->argument.get());
+            break;
+        case NodeType::TryCatch: {
+            auto statement = static_cast<TryCatchStatement *>(node);
+            child(statement->tryBlock.get());
+            child(statement->catchBlock.get());
+            child(statement->finallyBlock.get());
+            break;
+        }
+        case NodeType::ModelDefinition: {
+            auto model = static_cast<ModelDefinitionStatement *>(node);
+            child(model->constructor.get());
+            child(model->privateBlock.get());
+            child(model->publicBlock.get());
+            break;
+        }
+        case NodeType::ModelBlock:
+            for (const auto &statement: static_cast<ModelBlock *>(node)->getBody()) child(statement.get());
+            break;
+        default:
+            // Leaf nodes: literals, identifiers, type definitions, imports, break and JS snippets
+            break;
+    }
+}
+
+void ASTWalker::walk(Statement *node, const std::function<bool(Statement *)> &visit) {
+    if (node == nullptr || !visit(node)) {
+        return;
+    }
+    forEachChild(node, [&visit](Statement *child) {
+        walk(child, visit);
+    });
+}
+
+void ASTWalker::rewriteExpressions(Statement *node, const std::function<void(std::unique_ptr<Expression> &)> &visit) {
+    auto expression = [&visit](std::unique_ptr<Expression> &slot) {
+        if (slot) {
+            rewriteExpressions(slot.get(), visit);
+            visit(slot);
+        }
+    };
+    auto statement = [&expression, &visit](std::unique_ptr<Statement> &slot) {
+        if (auto exp = dynamic_cast<Expression *>(slot.get())) {
+            slot.release();
+            std::unique_ptr<Expression> owned(exp);
+            expression(owned);
+            slot = std::move(owned);
+        }
+        else if (slot) {
+            rewriteExpressions(slot.get(), visit);
+        }
+    };
+    auto nested = [&visit](Statement *child) {
+        if (child) {
+            rewriteExpressions(child, visit);
+        }
+    };
+
+    switch (node->kind) {
+        case NodeType::Program:
+            for (auto &child: static_cast<Program *>(node)->body) statement(child);
+            break;
+        case NodeType::Block:
+            for (auto &child: static_cast<BlockStatement *>(node)->body) statement(child);
+            break;
+        case NodeType::VariableStatement:
+            for (const auto &declaration: static_cast<VariableStatement *>(node)->declarations) nested(declaration.get());
+            break;
+        case NodeType::VariableDeclaration:
+            expression(static_cast<VariableDeclaration *>(node)->value);
+            break;
+        case NodeType::BinaryExpression: {
+            auto binary = static_cast<BinaryExpression *>(node);
+            expression(binary->left);
+            expression(binary->right);
+            break;
+        }
+        case NodeType::LogicalExpression: {
+            auto logical = static_cast<LogicalExpression *>(node);
+            expression(logical->left);
+            expression(logical->right);
+            break;
+        }
+        case NodeType::UnaryExpression:
+            expression(static_cast<UnaryExpression *>(node)->operand);
+            break;
+        case NodeType::AssignmentExpression: {
+            auto assignment = static_cast<AssignmentExpression *>(node);
+            expression(assignment->assignee);
+            expression(assignment->value);
+            break;
+        }
+        case NodeType::MemberExpression: {
+            auto member = static_cast<MemberExpression *>(node);
+            expression(member->targetObject);
+            if (member->isComputed) {
+                expression(member->property);
+            }
+            break;
+        }
+        case NodeType::CallExpression: {
+            auto call = static_cast<CallExpression *>(node);
+            expression(call->callee);
+            for (auto &arg: call->args) expression(arg);
+            break;
+        }
+        case NodeType::Object:
+            for (const auto &property: static_cast<ObjectLiteral *>(node)->properties) nested(property.get());
+            break;
+        case NodeType::ObjectProperty:
+            expression(static_cast<ObjectProperty *>(node)->value);
+            break;
+        case NodeType::ArrayLiteral:
+            for (auto &element: static_cast<ArrayLiteral *>(node)->arr) expression(element);
+            break;
+        case NodeType::IfStatement: {
+            auto ifStatement = static_cast<IfStatement *>(node);
+            expression(ifStatement->condition);
+            statement(ifStatement->consequent);
+            statement(ifStatement->alternate);
+            break;
+        }
+        case NodeType::UnlessStatement: {
+            auto unless = static_cast<UnlessStatement *>(node);
+            expression(unless->condition);
+            statement(unless->consequent);
+            statement(unless->alternate);
+            break;
+        }
+        case NodeType::WhileStatement: {
+            auto loop = static_cast<WhileStatement *>(node);
+            expression(loop->condition);
+            nested(loop->body.get());
+            break;
+        }
+        case NodeType::DoWhileStatement: {
+            auto loop = static_cast<DoWhileStatement *>(node);
+            nested(loop->body.get());
+            expression(loop->condition);
+            break;
+        }
+        case NodeType::ForStatement: {
+            auto loop = static_cast<ForStatement *>(node);
+            expression(loop->startValue);
+            expression(loop->endValue);
+            expression(loop->step);
+            nested(loop->body.get());
+            break;
+        }
+        case NodeType::ForEachStatement: {
+            auto loop = static_cast<ForEachStatement *>(node);
+            expression(loop->iterable);
+            nested(loop->body.get());
+            break;
+        }
+        case NodeType::FunctionDeclaration:
+            nested(static_cast<FunctionDeclaration *>(node)->body.get());
+            break;
+        case NodeType::FunctionExpression:
+            nested(static_cast<FunctionExpression *>(node)->body.get());
+            break;
+        case NodeType::ReturnStatement:
+            expression(static_cast<ReturnStatement *>(node)->argument);
+            break;
+        case NodeType::TryCatch: {
+            auto tryCatch = static_cast<TryCatchStatement *>(node);
+            nested(tryCatch->tryBlock.get());
+            nested(tryCatch->catchBlock.get());
+            nested(tryCatch->finallyBlock.get());
+            break;
+        }
+        case NodeType::ModelDefinition:
+            forEachChild(node, nested);
+            break;
+        case NodeType::ModelBlock:
+            for (const auto &member: static_cast<ModelBlock *>(node)->getBody()) nested(member.get());
+            break;
+        default:
+            break;
+    }
+}
@@ -0,0 +1,22 @@
+#ifndef BOSSCRIPT_ASTWALKER_H
+#define BOSSCRIPT_ASTWALKER_H
+
+#include <functional>
+#include "Statements.h"
+
+class ASTWalker {
+public:
+    // Calls visit for every direct, non-null child of node, in source order
+    static void forEachChild(Statement *node, const std::function<void(Statement *)> &visit);
+
+    // Pre-order traversal. Children of a node are skipped if visit returns false for it
+    static void walk(Statement *node, const std::function<bool(Statement *)> &visit);
+
+    // Post-order traversal over every expression slot under node, expression statements included.
+    // visit may replace the expression it is given. Names (non-computed properties, loop counters,
+    // parameters) are not visited.
+    static void rewriteExpressions(Statement *node, const std::function<void(std::unique_ptr<Expression> &)> &visit);
+};
+
+
+#endif //BOSSCRIPT_ASTWALKER_H
@@ -8,8 +8,17 @@
 #include <string>
 #include <utility>
 #include <vector>
+#include <optional>
+#include <memory>
 #include "Expression/Expression.h"
 
+// Representation of an array's elements, ordered so that an array only ever moves to a later kind
+enum class ElementKind {
+    SmallInt,
+    Double,
+    Generic
+};
+
 class Identifier: public Expression {
 public:
     std::string symbol;
@@ -36,6 +45,17 @@ public:
     bool isComputed;
     std::unique_ptr<Expression> targetObject;
     std::unique_ptr<Expression> property;
+    // Index of the model field slot, when the target's model is known at compile time
+    std::optional<size_t> slot;
+    // Index into the model's method table, when the property names a method of a statically known model
+    std::optional<size_t> methodIndex;
+    std::optional<size_t> cacheSite;
+    // Compound assignments read the property before storing it, through their own load site
+    std::optional<size_t> loadSite;
+    // Computed access whose index is known to be a small integer
+    bool hasIntegerIndex = false;
+    // Element kind of the array, when the target is a local array whose kind is known for its whole lifetime
+    std::optional<ElementKind> elementKind;
 
     MemberExpression(bool isComputed, std::unique_ptr<Expression> targetObject, std::unique_ptr<Expression> property)
         : Expression(NodeType::MemberExpression),
@@ -73,7 +93,7 @@ public:
     std::string mOperator;
 
     BinaryExpression(std::unique_ptr<Expression> left, std::unique_ptr<Expression> right, std::string mOperator)
-        : Expression(NodeType::LogicalExpression),
+        : Expression(NodeType::BinaryExpression),
             left(std::move(left)),
             right(std::move(right)),
             mOperator(std::move(mOperator))
@@ -102,6 +122,8 @@ public:
 class StringLiteral : public Expression {
 public:
     std::string value;
+    // Index into the program's string table, literals with equal values share it
+    std::optional<size_t> internedId;
 
     explicit StringLiteral(std::string value) : Expression(NodeType::StringLiteral), value(std::move(value)) {}
 };
@@ -136,6 +158,9 @@ public:
 class ObjectLiteral : public Expression {
 public:
     std::vector<std::unique_ptr<ObjectProperty>> properties;
+    std::optional<size_t> shape;
+    // Never outlives the function invocation that allocates it
+    bool inArena = false;
 
     explicit ObjectLiteral(std::vector<std::unique_ptr<ObjectProperty>> &properties)
         : Expression(NodeType::Object),
@@ -146,6 +171,9 @@ public:
 class ArrayLiteral : public Expression {
 public:
     std::vector<std::unique_ptr<Expression>> arr;
+    // Never outlives the function invocation that allocates it
+    bool inArena = false;
+    std::optional<ElementKind> elementKind;
 
     explicit ArrayLiteral(std::vector<std::unique_ptr<Expression>> arr)
         : Expression(NodeType::ArrayLiteral),
@@ -157,6 +185,9 @@ class CallExpression : public Expression {
 public:
     std::vector<std::unique_ptr<Expression>> args;
     std::unique_ptr<Expression> callee;
+    std::optional<size_t> cacheSite;
+    // Model constructor call whose instance never outlives the function invocation that allocates it
+    bool inArena = false;
 
     CallExpression(std::vector<std::unique_ptr<Expression>> args, std::unique_ptr<Expression> callee)
         : Expression(NodeType::CallExpression),
@@ -15,6 +15,8 @@ public:
 
     explicit Statement(NodeType kind);
 
+    virtual ~Statement() = default;
+
     virtual std::string toString();
 };
 
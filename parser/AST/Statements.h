@@ -12,6 +12,9 @@
 #include <sstream>
 #include <iostream>
 
+class ModelLayout;
+class MethodTable;
+
 class EmptyStatement : public Statement {
 public:
     explicit EmptyStatement() : Statement(NodeType::EmptyStatement){}
@@ -79,17 +82,32 @@ class FunctionParameter : public Statement {
 public:
     std::unique_ptr<Identifier> identifier;
     std::unique_ptr<TypeAnnotation> typeAnnotation;
+    // Captured by a closure that may see it change, so it lives in a shared cell
+    bool inCell = false;
 
     FunctionParameter(std::unique_ptr<Identifier> identifier, std::unique_ptr<TypeAnnotation> typeAnnotation)
         : Statement(NodeType::FunctionParameter), identifier(std::move(identifier)), typeAnnotation(std::move(typeAnnotation)) {}
 };
 
+// Variable of an enclosing function copied into a closure when it is created. Variables that can change
+// after that are shared through a cell instead of copied.
+class CapturedVariable {
+public:
+    std::string name;
+    bool byValue;
+};
+
 class FunctionDeclaration : public Statement {
 public:
     std::unique_ptr<Identifier> name;
     std::vector<std::unique_ptr<FunctionParameter>> params;
     std::unique_ptr<TypeAnnotation> returnType;
     std::unique_ptr<BlockStatement> body;
+    std::vector<CapturedVariable> captures;
+    // The function's name is captured by a closure that may run before the function is declared
+    bool nameInCell = false;
+    // Budget charged by the check on entry, 0 if the function has no check
+    size_t safepointCost = 0;
 
     FunctionDeclaration(std::unique_ptr<Identifier> name,
                         std::vector<std::unique_ptr<FunctionParameter>> params,
@@ -103,6 +121,8 @@ public:
     std::vector<std::unique_ptr<FunctionParameter>> params;
     std::unique_ptr<TypeAnnotation> returnType;
     std::unique_ptr<BlockStatement> body;
+    std::vector<CapturedVariable> captures;
+    size_t safepointCost = 0;
 
     FunctionExpression(std::vector<std::unique_ptr<FunctionParameter>> &params,
                        std::unique_ptr<TypeAnnotation> returnType, std::unique_ptr<BlockStatement> body)
@@ -113,6 +133,10 @@ public:
 class ReturnStatement : public Statement {
 public:
     std::unique_ptr<Expression> argument;
+    // The returned call can reuse the caller's frame
+    bool isTailCall = false;
+    // Tail call of the enclosing function itself, which can be compiled as a jump to its start
+    bool isSelfTailCall = false;
 
     explicit ReturnStatement(std::unique_ptr<Expression> argument) : Statement(NodeType::ReturnStatement), argument(std::move(argument)) {}
 };
@@ -129,31 +153,40 @@ public:
 };
 
 class WhileStatement : public Statement {
+public:
     std::unique_ptr<Expression> condition;
     std::unique_ptr<BlockStatement> body;
+    // Budget charged by the check on the back-edge, 0 if the loop has no check
+    size_t safepointCost = 0;
 
-public:
     WhileStatement(std::unique_ptr<Expression> condition, std::unique_ptr<BlockStatement> body)
         : Statement(NodeType::WhileStatement), condition(std::move(condition)), body(std::move(body)) {}
 };
 
 class DoWhileStatement : public Statement {
+public:
     std::unique_ptr<Expression> condition;
     std::unique_ptr<BlockStatement> body;
+    size_t safepointCost = 0;
 
-public:
     DoWhileStatement(std::unique_ptr<Expression> condition, std::unique_ptr<BlockStatement> body)
             : Statement(NodeType::DoWhileStatement), condition(std::move(condition)), body(std::move(body)) {}
 };
 
 class ForStatement : public Statement {
+public:
     std::unique_ptr<Identifier> counter;
     std::unique_ptr<Expression> startValue;
     std::unique_ptr<Expression> endValue;
     std::unique_ptr<Expression> step;
     std::unique_ptr<BlockStatement> body;
+    // Bounds and step are loop-invariant and only the loop changes the counter
+    bool isCounted = false;
+    // Counted loop whose counter stays a small integer for every iteration
+    bool hasIntegerCounter = false;
+    bool counterInCell = false;
+    size_t safepointCost = 0;
 
-public:
     ForStatement(std::unique_ptr<Identifier> counter, std::unique_ptr<Expression> startValue, std::unique_ptr<Expression> endValue, std::unique_ptr<Expression> step, std::unique_ptr<BlockStatement> body)
          : Statement(NodeType::ForStatement),
             counter(std::move(counter)),
@@ -164,6 +197,29 @@ public:
          {}
 };
 
+// za svako (element od niz) { ... }
+class ForEachStatement : public Statement {
+public:
+    std::unique_ptr<Identifier> element;
+    std::unique_ptr<Expression> iterable;
+    std::unique_ptr<BlockStatement> body;
+    // Iterations only read konst bindings and write their own locals or reduction targets
+    bool isParallel = false;
+    // Outer variables the body only updates with one associative operator, in order of first update
+    std::vector<std::string> reductions;
+    // Kind of the iterated array's elements, when it is a literal or a local array whose kind is known
+    std::optional<ElementKind> elementKind;
+    bool elementInCell = false;
+    size_t safepointCost = 0;
+
+    ForEachStatement(std::unique_ptr<Identifier> element, std::unique_ptr<Expression> iterable, std::unique_ptr<BlockStatement> body)
+        : Statement(NodeType::ForEachStatement),
+            element(std::move(element)),
+            iterable(std::move(iterable)),
+            body(std::move(body))
+        {}
+};
+
 class UnlessStatement : public Statement {
 public:
     std::unique_ptr<Expression> condition;
@@ -171,14 +227,15 @@ public:
     std::unique_ptr<Statement> alternate;
 
     UnlessStatement(std::unique_ptr<Expression> condition, std::unique_ptr<Statement> consequent, std::unique_ptr<Statement> alternate)
-            : Statement(NodeType::IfStatement), condition(std::move(condition)), consequent(std::move(consequent)), alternate(std::move(alternate)) {}
+            : Statement(NodeType::UnlessStatement), condition(std::move(condition)), consequent(std::move(consequent)), alternate(std::move(alternate)) {}
 };
 
 class VariableDeclaration : public Statement {
+public:
     std::string name;
     std::unique_ptr<Expression> value;
+    bool inCell = false;
 
-public:
     VariableDeclaration(std::string name, std::unique_ptr<Expression> value)
         : Statement(NodeType::VariableDeclaration), name(std::move(name)), value(std::move(value)) {}
 };
@@ -193,10 +250,10 @@ public:
 };
 
 class TypeProperty : public Statement {
+public:
     std::string name;
     std::unique_ptr<TypeAnnotation> type;
 
-public:
     TypeProperty(std::string name, std::unique_ptr<TypeAnnotation> type)
         : Statement(NodeType::TypePropertyDefinition), name(std::move(name)), type(std::move(type)) {}
 };
@@ -216,8 +273,8 @@ private:
     std::vector<std::unique_ptr<Statement>> body;
 
 public:
-    std::vector<std::unique_ptr<Statement>> getBody(){
-        return std::move(body);
+    const std::vector<std::unique_ptr<Statement>> &getBody() const {
+        return body;
     }
 
     void addStatement(std::unique_ptr<Statement> stmt){
@@ -242,6 +299,9 @@ public:
     std::unique_ptr<FunctionDeclaration> constructor;
     std::unique_ptr<ModelBlock> privateBlock;
     std::unique_ptr<ModelBlock> publicBlock;
+    std::shared_ptr<ModelLayout> layout;
+    std::shared_ptr<MethodTable> methodTable;
+    bool nameInCell = false;
 
     ModelDefinitionStatement(std::unique_ptr<Identifier> className, std::unique_ptr<Identifier> parentClassName, std::unique_ptr<FunctionDeclaration> constructor, std::unique_ptr<ModelBlock> privateBlock, std::unique_ptr<ModelBlock> publicBlock)
             : Statement(NodeType::ModelDefinition),
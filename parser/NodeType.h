@@ -27,6 +27,7 @@ enum class NodeType{
     WhileStatement,
     DoWhileStatement,
     ForStatement,
+    ForEachStatement,
     FunctionDeclaration,
     ReturnStatement,
     TypeDefinition,
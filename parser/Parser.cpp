@@ -758,19 +758,25 @@ std::unique_ptr<DoWhileStatement> Parser::parseDoWhileStatement() {
     );
 }
 
-std::unique_ptr<ForStatement> Parser::parseForStatement() {
+std::unique_ptr<Statement> Parser::parseForStatement() {
     expect(TokenType::Za, "Expected 'za'");
     expect(TokenType::Svako, "Missing 'svako' following 'za'");
     expect(TokenType::OpenParen, "Expected '('");
     auto counter = parseIdentifier();
     expect(TokenType::Od, "Expected starting condition for loop, missing keyword 'od'");
     auto startCondition = parseExpression();
-    expect(TokenType::Do, "Expected ending condition for loop, missing keyword 'do'");
-    auto endCondition = parseExpression();
+
+    // Without 'do' the loop goes over the elements of an array: za svako (x od niz) { ... }
+    bool forEach = current().type == TokenType::CloseParen;
+    std::unique_ptr<Expression> endCondition;
     std::unique_ptr<Expression> step;
-    if (current().type == TokenType::Korak) {
-        consume(/*korak*/);
-        step = parseExpression();
+    if (!forEach) {
+        expect(TokenType::Do, "Expected ending condition for loop, missing keyword 'do'");
+        endCondition = parseExpression();
+        if (current().type == TokenType::Korak) {
+            consume(/*korak*/);
+            step = parseExpression();
+        }
     }
     expect(TokenType::CloseParen, "Expected ')'");
 
@@ -789,6 +795,13 @@ std::unique_ptr<ForStatement> Parser::parseForStatement() {
         loopBody = parseBlockStatement();
     }
 
+    if (forEach) {
+        return std::make_unique<ForEachStatement>(
+                std::move(counter),
+                std::move(startCondition),
+                std::move(loopBody)
+        );
+    }
     return std::make_unique<ForStatement>(
             std::move(counter),
             std::move(startCondition),
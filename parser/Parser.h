@@ -67,7 +67,7 @@ private:
 
     std::unique_ptr<DoWhileStatement> parseDoWhileStatement();
 
-    std::unique_ptr<ForStatement> parseForStatement();
+    std::unique_ptr<Statement> parseForStatement();
 
     std::unique_ptr<BreakStatement> parseBreakStatement();
 
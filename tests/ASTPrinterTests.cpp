@@ -0,0 +1,37 @@
+#include "Test.h"
+#include "../parser/Parser.h"
+#include "../parser/AST/ASTPrinter.h"
+
+static std::string parseAndPrint(const std::string &source) {
+    Parser parser(false);
+    auto program = parser.parseProgram(source);
+    return ASTPrinter::print(&program);
+}
+
+// Printing, parsing the printed program and printing it again gives the same text
+static void expectRoundTrip(const std::string &source) {
+    auto printed = parseAndPrint(source);
+    auto reprinted = parseAndPrint(printed);
+    expect(printed == reprinted, "Ispis se promijenio:\n" + printed + "\n" + reprinted);
+}
+
+TEST(nestedUnaryKeepsOperand) {
+    auto output = parseAndPrint("var a = -(-x); var b = - -x; var c = +(+x); var d = !!x; var e = -(++x);");
+    expectContains(output, "var a = -(-x);");
+    expectContains(output, "var b = -(-x);");
+    expectContains(output, "var c = +(+x);");
+    expectContains(output, "var d = !(!x);");
+    expectContains(output, "var e = -(++x);");
+    expectNotContains(output, "--x");
+}
+
+TEST(nestedUnaryRoundTrips) {
+    expectRoundTrip(R"(
+funkcija f(x) {
+    var a = -(-x);
+    var b = - -x + -(+x);
+    ++x;
+    vrati -(-(-a)) * !(!b);
+}
+)");
+}
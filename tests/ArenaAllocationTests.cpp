@@ -0,0 +1,97 @@
+#include "Test.h"
+
+TEST(localModelInstanceIsInArena) {
+    auto output = compileAndPrint(R"(
+model Cvor {
+    konstruktor(v){
+        @v = v * 2;
+    }
+    javno {
+        var v;
+    }
+}
+funkcija f() {
+    var c = Cvor(1);
+    vrati c.v;
+}
+)");
+    expectContains(output, "var c = /*arena*/Cvor(1)");
+}
+
+TEST(constructorStoringInstanceIsNotInArena) {
+    auto output = compileAndPrint(R"(
+var registar = [];
+model Cvor {
+    konstruktor(v){
+        @v = v;
+        registar.dodaj(@);
+    }
+    javno {
+        var v;
+    }
+}
+funkcija f() {
+    var c = Cvor(1);
+    vrati c.v;
+}
+)");
+    expectNotContains(output, "/*arena*/Cvor");
+}
+
+TEST(constructorCallingMethodIsNotInArena) {
+    auto output = compileAndPrint(R"(
+model Cvor {
+    konstruktor(v){
+        @v = v;
+        @prijavi();
+    }
+    javno {
+        var v;
+        funkcija prijavi() {}
+    }
+}
+funkcija f() {
+    var c = Cvor(1);
+    vrati c.v;
+}
+)");
+    expectNotContains(output, "/*arena*/Cvor");
+}
+
+TEST(allocationInLoopIsNotInArena) {
+    // The arena is reset only when f returns, one allocation per iteration would pile up until then
+    auto output = compileAndPrint(R"(
+funkcija f(n) {
+    var suma = 0;
+    za svako (i od 1 do n) {
+        var a = [i, i * 2];
+        suma += a[1];
+    }
+    dok (suma > 0) {
+        var b = {x: suma};
+        suma = suma - b.x;
+    }
+    var c = [suma];
+    vrati c[0];
+}
+)");
+    expectNotContains(output, "var a = /*arena*/");
+    expectNotContains(output, "var b = /*arena*/");
+    expectContains(output, "var c = /*arena*/");
+}
+
+TEST(allocationInFunctionDeclaredInLoopIsInArena) {
+    // The nested function's own arena is reset on each of its returns
+    auto output = compileAndPrint(R"(
+funkcija f(n) {
+    za svako (i od 1 do n) {
+        var g = funkcija(k) {
+            var a = [k, k];
+            vrati a[0];
+        };
+        ispis(g(i));
+    }
+}
+)");
+    expectContains(output, "var a = /*arena*/");
+}
@@ -0,0 +1,40 @@
+#include "Test.h"
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+#include "../compiler/AsyncIO.h"
+
+TEST(readsFinishWithinInFlightLimit) {
+    // Far more reads than the loop lets run at once, one of them of a file that does not exist
+    auto directory = std::filesystem::temp_directory_path();
+    auto path = (directory / "bosscript_asyncio_test.txt").string();
+    auto missing = (directory / "bosscript_asyncio_nema.txt").string();
+    std::filesystem::remove(missing);
+    std::string content(100000, 'b');
+    std::ofstream(path, std::ios::binary) << content;
+
+    EventLoop loop(4);
+    std::vector<Task<std::string>> readers;
+    for (int i = 0; i < 32; i++) {
+        readers.push_back(readFile(loop, i == 17 ? missing : path));
+    }
+    loop.run(readers);
+    std::filesystem::remove(path);
+
+    expect(loop.peakInFlight() <= 4, "Više čitanja u toku nego što petlja dozvoljava");
+    for (int i = 0; i < 32; i++) {
+        expect(readers[i].done(), "Čitanje nije završeno");
+        if (i == 17) {
+            std::string error;
+            try {
+                readers[i].result();
+            } catch (const std::runtime_error &e) {
+                error = e.what();
+            }
+            expectContains(error, "Nije moguće pročitati fajl '" + missing + "'");
+        } else {
+            expect(readers[i].result() == content, "Pročitani sadržaj se razlikuje od fajla");
+        }
+    }
+}
@@ -0,0 +1,49 @@
+#include "Test.h"
+#include <thread>
+#include <vector>
+#include "../compiler/Channel.h"
+
+TEST(closedChannelDrainsBeforeEnding) {
+    Channel<int> channel(2);
+    expect(channel.send(1) && channel.send(2), "Slanje u kanal koji nije pun nije uspjelo");
+    channel.close();
+    expect(!channel.send(3), "Poruka je poslana u zatvoren kanal");
+
+    auto first = channel.receive();
+    auto second = channel.receive();
+    expect(first && *first == 1 && second && *second == 2, "Poruke poslane prije zatvaranja nisu primljene redom");
+    expect(!channel.receive(), "Prazan zatvoren kanal je vratio poruku");
+}
+
+TEST(boundedChannelKeepsOrderUnderBackpressure) {
+    // The producer blocks on the full channel most of the time and closes it after its last message
+    const int count = 10000;
+    Channel<std::vector<int>> channel(2);
+    std::thread producer([&]() {
+        for (int i = 0; i < count; i++) {
+            channel.send(std::vector<int>(4, i));
+        }
+        channel.close();
+    });
+    int expected = 0;
+    while (auto message = channel.receive()) {
+        expect(message->size() == 4 && (*message)[0] == expected, "Poruka je izgubljena ili primljena van reda");
+        expected++;
+    }
+    producer.join();
+    expect(expected == count, "Nisu primljene sve poruke");
+}
+
+TEST(closeReleasesBlockedSender) {
+    Channel<int> channel(1);
+    channel.send(1);
+    bool sent = true;
+    std::thread sender([&]() {
+        sent = channel.send(2);
+    });
+    channel.close();
+    sender.join();
+    expect(!sent, "Pošiljalac blokiran na punom kanalu je poslao poruku nakon zatvaranja");
+    auto message = channel.receive();
+    expect(message && *message == 1 && !channel.receive(), "Zatvoren kanal nije ispražnjen");
+}
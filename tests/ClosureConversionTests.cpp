@@ -0,0 +1,83 @@
+#include "Test.h"
+
+TEST(unassignedVariablesAreCapturedByValue) {
+    auto output = compileAndPrint(R"(
+var globalno = 1;
+funkcija f(a) {
+    var b = a * 2;
+    vrati funkcija() {
+        vrati a + b + globalno;
+    };
+}
+)");
+    expectContains(output, "/*captures a, b*/");
+    expectNotContains(output, "/*cell*/");
+}
+
+TEST(assignedVariableLivesInCell) {
+    auto output = compileAndPrint(R"(
+funkcija f() {
+    var n = 0;
+    var b = 2;
+    vrati funkcija() {
+        n = n + 1;
+        vrati funkcija() {
+            vrati n + b;
+        };
+    };
+}
+)");
+    expectContains(output, "var n/*cell*/ = 0");
+    expectContains(output, "var b = 2");
+    // The inner function's captures are passed through the outer one
+    expectContains(output, "/*captures &n, b*/ {\n        n = (n + 1);");
+    expectContains(output, "/*captures &n, b*/ {\n            vrati (n + b);");
+}
+
+TEST(variableDeclaredAfterClosureLivesInCell) {
+    // g exists as soon as the block is entered, before k has a value
+    auto output = compileAndPrint(R"(
+funkcija f() {
+    funkcija g() {
+        vrati k;
+    }
+    var k = 5;
+    vrati g;
+}
+)");
+    expectContains(output, "var k/*cell*/ = 5");
+    expectContains(output, "/*captures &k*/");
+}
+
+TEST(closureInCountedLoopSharesCounter) {
+    // One counter for the whole loop: every closure sees its current value, not the value of its iteration
+    auto output = compileAndPrint(R"(
+funkcija f() {
+    var zatvaranja = [];
+    za svako (i od 0 do 3) {
+        zatvaranja.dodaj(funkcija() {
+            vrati i;
+        });
+    }
+    vrati zatvaranja;
+}
+)");
+    expectContains(output, "(i/*cell*/ od 0 do 3)");
+    expectContains(output, "/*captures &i*/");
+}
+
+TEST(closureInForEachLoopCopiesElement) {
+    auto output = compileAndPrint(R"(
+funkcija f(niz) {
+    var zatvaranja = [];
+    za svako (x od niz) {
+        zatvaranja.dodaj(funkcija() {
+            vrati x;
+        });
+    }
+    vrati zatvaranja;
+}
+)");
+    expectContains(output, "(x od niz)");
+    expectContains(output, "/*captures x*/");
+}
@@ -0,0 +1,60 @@
+#include "Test.h"
+
+TEST(negativeRemainderFoldsToNegativeZero) {
+    // -5 % 5 is -0 in doubles, an integer remainder would give 0
+    auto output = compileAndPrint("var a = -5 % 5; var b = 5 % -5; var c = 7 % 5;");
+    expectContains(output, "var a = -0;");
+    expectContains(output, "var b = 0;");
+    expectContains(output, "var c = 2;");
+}
+
+TEST(integerOverflowFoldsToDouble) {
+    auto output = compileAndPrint("var a = 2147483647 + 1; var b = -2147483648 - 1; var c = 65536 * 65536;");
+    expectContains(output, "var a = 2147483648;");
+    expectContains(output, "var b = -2147483649;");
+    expectContains(output, "var c = 4294967296;");
+}
+
+TEST(inexactDivisionFoldsToDouble) {
+    auto output = compileAndPrint("var a = 7 / 2; var b = 6 / 3; var c = 0 / -5;");
+    expectContains(output, "var a = 3.5;");
+    expectContains(output, "var b = 2;");
+    expectContains(output, "var c = -0;");
+}
+
+TEST(divisionByZeroIsNotFolded) {
+    auto output = compileAndPrint("var a = 1 / 0; var b = 1 % 0;");
+    expectContains(output, "var a = (1 / 0);");
+    expectContains(output, "var b = (1 % 0);");
+}
+
+TEST(constantConditionPrunesDeadBranch) {
+    auto output = compileAndPrint(R"(
+ako (1 < 2) {
+    ispis("da");
+} inace {
+    ispis("ne");
+}
+ako (netacno) {
+    ispis("nikad");
+}
+)");
+    expectContains(output, "\"da\")");
+    expectNotContains(output, "\"ne\"");
+    expectNotContains(output, "nikad");
+    expectNotContains(output, "ako");
+}
+
+TEST(codeAfterReturnIsDroppedButDeclarationsKept) {
+    auto output = compileAndPrint(R"(
+funkcija f() {
+    vrati g();
+    ispis("mrtvo");
+    funkcija g() {
+        vrati 1;
+    }
+}
+)");
+    expectNotContains(output, "mrtvo");
+    expectContains(output, "funkcija g()");
+}
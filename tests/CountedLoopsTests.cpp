@@ -0,0 +1,75 @@
+#include "Test.h"
+
+// Whether the 'za svako' line whose header starts with the given text is marked as counted
+static bool isCounted(const std::string &output, const std::string &header) {
+    auto position = output.find("(" + header);
+    expect(position != std::string::npos, "Nije pronađena petlja \"" + header + "\" u:\n" + output);
+    auto line = output.rfind('\n', position);
+    return output.substr(line + 1, position - line - 1).find("/*counted*/") != std::string::npos;
+}
+
+TEST(loopWithInvariantBoundsIsCounted) {
+    auto output = compileAndPrint(R"(
+funkcija zbir(n) {
+    var s = 0;
+    za svako (i od 0 do n * 2 korak 2) {
+        s += i;
+    }
+    vrati s;
+}
+)");
+    expect(isCounted(output, "i od 0 do (n * 2) korak 2)"), "Petlja nije brojačka:\n" + output);
+}
+
+TEST(counterInItsOwnBoundIsNotCounted) {
+    auto output = compileAndPrint(R"(
+funkcija f(i) {
+    za svako (j od 0 do 3) {
+        ispis(j);
+    }
+    za svako (i od 0 do i + 5) {
+        ispis(i);
+    }
+}
+)");
+    expect(isCounted(output, "j od 0 do 3)"), "Petlja po j nije brojačka:\n" + output);
+    expect(!isCounted(output, "i od 0 do (i + 5))"), "Petlja po i je brojačka:\n" + output);
+}
+
+TEST(boundAssignedInBodyIsNotCounted) {
+    auto output = compileAndPrint(R"(
+funkcija f(n) {
+    za svako (i od 0 do n) {
+        n = n - 1;
+    }
+}
+)");
+    expect(!isCounted(output, "i od 0 do n)"), "Petlja je brojačka:\n" + output);
+}
+
+TEST(counterAssignedInBodyIsNotCounted) {
+    auto output = compileAndPrint(R"(
+funkcija f(n) {
+    za svako (i od 0 do n) {
+        ++i;
+    }
+}
+)");
+    expect(!isCounted(output, "i od 0 do n)"), "Petlja je brojačka:\n" + output);
+}
+
+TEST(globalBoundWithCallInBodyIsNotCounted) {
+    // g may change granica between iterations
+    auto output = compileAndPrint(R"(
+var granica = 10;
+funkcija g() {
+    granica = 5;
+}
+funkcija f() {
+    za svako (i od 0 do granica) {
+        g();
+    }
+}
+)");
+    expect(!isCounted(output, "i od 0 do granica)"), "Petlja je brojačka:\n" + output);
+}
@@ -0,0 +1,25 @@
+#include "Test.h"
+
+TEST(smallIntArrayStaysPacked) {
+    auto output = compileAndPrint(R"(
+funkcija f() {
+    var a = [1, 2, 3];
+    a[1] = 5;
+    ispis(a[0]);
+}
+)");
+    expectContains(output, "var a = /*arena*//*smi*/[1, 2, 3]");
+}
+
+TEST(storeInLoopBoundWidensArray) {
+    auto output = compileAndPrint(R"(
+funkcija f() {
+    var a = [1, 2, 3];
+    za svako (i od (a[0] = "tekst") do 3) {
+        ispis(i);
+    }
+    ispis(a[0]);
+}
+)");
+    expectNotContains(output, "/*smi*/");
+}
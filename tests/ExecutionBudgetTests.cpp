@@ -0,0 +1,58 @@
+#include "Test.h"
+#include <thread>
+#include "../compiler/ExecutionBudget.h"
+
+using Decision = ExecutionBudget::Decision;
+
+TEST(hookRunsWhenSliceIsUsed) {
+    int calls = 0;
+    ExecutionBudget budget(10, [&calls](ExecutionBudget &) {
+        calls++;
+        return Decision::Continue;
+    });
+    for (int i = 0; i < 3; i++) {
+        expect(budget.charge(3) == Decision::Continue, "Provjera unutar isječka nije nastavila");
+    }
+    expect(calls == 0 && budget.used() == 9, "Hook je pozvan prije kraja isječka");
+
+    expect(budget.charge(3) == Decision::Continue, "Hook je vratio Continue");
+    expect(calls == 1 && budget.used() == 12, "Hook nije pozvan na kraju isječka");
+    // The next slice starts full, 9 more fit in it
+    budget.charge(9);
+    expect(calls == 1 && budget.used() == 21, "Novi isječak nije pun");
+}
+
+TEST(interruptSuspendsAtNextCheck) {
+    int calls = 0;
+    ExecutionBudget budget(1000, [&calls](ExecutionBudget &) {
+        calls++;
+        return Decision::Suspend;
+    });
+    budget.charge(5);
+    std::thread([&budget]() { budget.interrupt(); }).join();
+
+    expect(budget.charge(1) == Decision::Suspend, "Prekid nije suspendovao poziv");
+    expect(calls == 1 && budget.used() == 6, "Hook nije pozvan jednom nakon prekida");
+    // The interrupt is cleared once the hook has seen it
+    expect(budget.charge(1) == Decision::Continue && calls == 1, "Prekid je ostao postavljen");
+    expect(budget.used() == 7, "Suspendovan poziv nije nastavio s punim isječkom");
+}
+
+TEST(cancelKeepsUsedCost) {
+    ExecutionBudget budget(5, [](ExecutionBudget &) {
+        return Decision::Cancel;
+    });
+    expect(budget.charge(2) == Decision::Continue, "Provjera unutar isječka nije nastavila");
+    expect(budget.charge(8) == Decision::Cancel, "Hook je vratio Cancel");
+    expect(budget.used() == 10, "Otkazan poziv nije zadržao potrošeno");
+}
+
+TEST(withoutHookBudgetOnlyCounts) {
+    ExecutionBudget budget(2);
+    for (int i = 0; i < 5; i++) {
+        expect(budget.charge(3) == Decision::Continue, "Bez hooka poziv mora nastaviti");
+    }
+    budget.interrupt();
+    expect(budget.charge(1) == Decision::Continue, "Bez hooka prekid mora nastaviti");
+    expect(budget.used() == 16, "Potrošeno nije zbir svih provjera");
+}
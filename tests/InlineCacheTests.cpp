@@ -0,0 +1,34 @@
+#include "Test.h"
+#include "../compiler/CompiledProgram.h"
+
+TEST(executionsHaveTheirOwnInlineCaches) {
+    auto program = CompiledProgram::compile(R"(
+funkcija f(o) {
+    vrati o.x;
+}
+)");
+    auto first = program->createInlineCaches();
+    auto second = program->createInlineCaches();
+    expect(first.sites.size() == 1, "Očekivano je jedno mjesto keširanja");
+
+    first.update(0, 7, 3);
+    expect(first.lookup(0, 7) == 3, "Keš ne vraća upisani indeks");
+    expect(!second.lookup(0, 7), "Drugo izvršavanje vidi tuđi keš");
+    expect(!program->createInlineCaches().lookup(0, 7), "Novo izvršavanje ne počinje od početnih keševa");
+}
+
+TEST(megamorphicSiteUsesItsOwnGlobalCache) {
+    auto program = CompiledProgram::compile(R"(
+funkcija f(o) {
+    vrati o.x;
+}
+)");
+    auto first = program->createInlineCaches();
+    auto second = program->createInlineCaches();
+    for (size_t shape = 0; shape <= InlineCache::maxEntries; shape++) {
+        first.update(0, shape, shape);
+    }
+    expect(first.sites[0].state == CacheState::Megamorphic, "Mjesto nije postalo megamorfno");
+    expect(first.lookup(0, 2) == 2, "Globalni keš ne vraća upisani indeks");
+    expect(second.sites[0].state == CacheState::Uninitialized && !second.lookup(0, 2), "Drugo izvršavanje vidi tuđi globalni keš");
+}
@@ -0,0 +1,150 @@
+#include "Test.h"
+#include "../compiler/ModelLayout.h"
+
+static const char *models = R"(
+model Roditelj {
+    konstruktor(a, b){
+        @a = a;
+        @b = b;
+    }
+    privatno {
+        funkcija tajna(){
+            vrati @a;
+        }
+    }
+    javno {
+        var a, b;
+
+        funkcija zbir(){
+            vrati @a + @tajna();
+        }
+
+        funkcija razlika(drugi: Roditelj){
+            vrati @a - drugi.tajna();
+        }
+    }
+}
+model Dijete < Roditelj {
+    konstruktor(a, b, c){
+        @a = a;
+        @b = b;
+        @c = c;
+    }
+    javno {
+        var c, a;
+
+        funkcija razlika(drugi: Roditelj){
+            vrati @c - drugi.b;
+        }
+
+        funkcija proizvod(drugi: Dijete){
+            vrati @a * drugi.c * drugi.razlika(drugi);
+        }
+    }
+}
+)";
+
+TEST(layoutKeepsParentSlots) {
+    auto parent = std::make_shared<ModelLayout>("Roditelj", nullptr);
+    parent->addField("a");
+    parent->addField("b");
+    ModelLayout child("Dijete", parent);
+    child.addField("c");
+    child.addField("a");
+
+    expect(child.size() == 3, "Dijete nema tri polja");
+    expect(child.slotOf("a") == 0 && child.slotOf("b") == 1, "Naslijeđena polja su pomjerena");
+    expect(child.slotOf("c") == 2, "Novo polje nije iza naslijeđenih");
+    expect(!parent->slotOf("c"), "Polje djeteta je dodano roditelju");
+
+    bool rejected = false;
+    try {
+        child.addField("c");
+    } catch (const std::runtime_error &) {
+        rejected = true;
+    }
+    expect(rejected, "Polje je deklarisano dva puta u istom modelu");
+}
+
+TEST(membersResolveToParentSlotsAndIndices) {
+    auto output = compileAndPrint(models);
+    // Fields and methods resolved against Roditelj keep the same slots and indices in Dijete
+    expectContains(output, "vrati (@c/*slot 2*/ - drugi.b/*slot 1*/)");
+    expectContains(output, "vrati ((@a/*slot 0*/ * drugi.c/*slot 2*/) * drugi.razlika/*method 2*/(drugi))");
+    expectContains(output, "vrati (@a/*slot 0*/ + @tajna/*method 0*/())");
+}
+
+TEST(overrideKeepsMethodIndex) {
+    auto output = compileAndPrint(std::string(models) + R"(
+funkcija f(r: Roditelj, d: Dijete) {
+    ispis(r.razlika(r));
+    ispis(d.razlika(r));
+    ispis(d.proizvod(d));
+}
+)");
+    expectContains(output, "r.razlika/*method 2*/(r)");
+    expectContains(output, "d.razlika/*method 2*/(r)");
+    expectContains(output, "d.proizvod/*method 3*/(d)");
+}
+
+TEST(privateMethodThroughOwnModelParameter) {
+    // Roditelj.razlika calls tajna on another Roditelj, which is allowed inside Roditelj
+    expect(compileError(models).empty(), "Poziv privatne metode unutar modela je odbijen");
+}
+
+TEST(privateMethodCalledOutsideModel) {
+    auto error = compileError(std::string(models) + R"(
+funkcija f(r: Roditelj) {
+    vrati r.tajna();
+}
+)");
+    expectContains(error, "Metoda 'tajna' je privatna u modelu Roditelj");
+}
+
+TEST(privateMethodCalledFromSubclassThroughParentParameter) {
+    auto error = compileError(std::string(models) + R"(
+model Unuk < Dijete {
+    konstruktor(){
+        @a = 1;
+    }
+    javno {
+        funkcija zaviri(drugi: Roditelj){
+            vrati drugi.tajna();
+        }
+    }
+}
+)");
+    expectContains(error, "Metoda 'tajna' je privatna u modelu Roditelj");
+}
+
+TEST(privateMethodCannotBeRedefined) {
+    auto error = compileError(std::string(models) + R"(
+model Unuk < Dijete {
+    konstruktor(){
+        @a = 1;
+    }
+    javno {
+        funkcija tajna(){
+            vrati 0;
+        }
+    }
+}
+)");
+    expectContains(error, "Model Unuk ne može redefinisati privatnu metodu 'tajna' modela Roditelj");
+}
+
+TEST(publicMethodCannotBecomePrivate) {
+    auto error = compileError(std::string(models) + R"(
+model Unuk < Dijete {
+    konstruktor(){
+        @a = 1;
+    }
+    privatno {
+        funkcija zbir(){
+            vrati 0;
+        }
+    }
+}
+)");
+    expectContains(error, "Model Unuk ne može redefinisati javnu metodu 'zbir' kao privatnu");
+}
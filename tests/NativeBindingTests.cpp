@@ -0,0 +1,45 @@
+#include "Test.h"
+#include <cmath>
+#include "../compiler/NativeBinding.h"
+
+static int32_t addNative(int32_t a, int32_t b) {
+    return a + b;
+}
+
+static double halfNative(double value) {
+    return value / 2;
+}
+
+TEST(integralNumbersAreSmallIntegers) {
+    expect(Value::number(42).isInteger() && Value::number(42).asInteger() == 42, "42 nije mali cijeli broj");
+    expect(Value::number(-7).asInteger() == -7, "-7 nije sačuvan");
+    expect(!Value::number(1.5).isInteger() && Value::number(1.5).asNumber() == 1.5, "1.5 nije double");
+    expect(!Value::number(-0.0).isInteger() && std::signbit(Value::number(-0.0).asNumber()), "-0 nije double");
+    expect(!Value::number(4294967296.0).isInteger(), "2^32 ne stane u int32");
+    expect(Value::integer(3).isNumber() && Value::integer(3).asNumber() == 3, "Mali cijeli broj nije broj");
+    expect(!Value::integer(3).isBoolean() && !Value::boolean(true).isInteger(), "Oznake se miješaju");
+}
+
+TEST(thunksConvertSmallIntegers) {
+    NativeFunction add = bindNative<&addNative>();
+    NativeFunction half = bindNative<&halfNative>();
+
+    Value integers[] = {Value::number(2), Value::integer(40)};
+    Value result = add(integers, 2);
+    expect(result.isInteger() && result.asInteger() == 42, "addNative nije vratio 42");
+
+    Value fraction[] = {Value::number(2), Value::number(0.5)};
+    bool rejected = false;
+    try {
+        add(fraction, 2);
+    } catch (const std::runtime_error &) {
+        rejected = true;
+    }
+    expect(rejected, "0.5 je prihvaćen kao cijeli broj");
+
+    // A double parameter takes small integers, and an integral double result becomes one
+    Value four = Value::integer(4);
+    expect(half(&four, 1).isInteger() && half(&four, 1).asInteger() == 2, "halfNative(4) nije 2");
+    Value three = Value::integer(3);
+    expect(half(&three, 1).asNumber() == 1.5, "halfNative(3) nije 1.5");
+}
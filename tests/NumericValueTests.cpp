@@ -0,0 +1,64 @@
+#include "Test.h"
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include "../compiler/NumericValue.h"
+
+static const int32_t minimum = std::numeric_limits<int32_t>::min();
+static const int32_t maximum = std::numeric_limits<int32_t>::max();
+
+static void expectDouble(std::optional<NumericValue> value, double expected, const std::string &what) {
+    expect(value && !value->isInteger(), what + " nije double");
+    expect(value->toDouble() == expected && std::signbit(value->toDouble()) == std::signbit(expected),
+           what + " je " + std::to_string(value->toDouble()));
+}
+
+static void expectInteger(std::optional<NumericValue> value, int32_t expected, const std::string &what) {
+    expect(value && value->isInteger(), what + " nije cijeli broj");
+    expect(value->asInteger() == expected, what + " je " + std::to_string(value->asInteger()));
+}
+
+TEST(ofKeepsIntegersInRange) {
+    expect(NumericValue::of(minimum).isInteger() && NumericValue::of(maximum).isInteger(), "Granice int32 nisu cijeli brojevi");
+    expect(!NumericValue::of(static_cast<double>(maximum) + 1).isInteger(), "2^31 je cijeli broj");
+    expect(!NumericValue::of(static_cast<double>(minimum) - 1).isInteger(), "-2^31 - 1 je cijeli broj");
+    expect(!NumericValue::of(-0.0).isInteger(), "-0 je cijeli broj");
+    expect(!NumericValue::of(0.5).isInteger(), "0.5 je cijeli broj");
+    expect(!NumericValue::of(std::nan("")).isInteger(), "NaN je cijeli broj");
+}
+
+TEST(applyAtInt32Minimum) {
+    auto min = NumericValue::of(minimum);
+    auto minusOne = NumericValue::of(-1);
+    expectDouble(NumericValue::apply("/", min, minusOne), 2147483648.0, "INT32_MIN / -1");
+    expectDouble(NumericValue::apply("%", min, minusOne), -0.0, "INT32_MIN % -1");
+    expectDouble(NumericValue::apply("*", min, minusOne), 2147483648.0, "INT32_MIN * -1");
+    expectDouble(NumericValue::apply("-", min, NumericValue::of(1)), -2147483649.0, "INT32_MIN - 1");
+    expectDouble(NumericValue::apply("+", NumericValue::of(maximum), NumericValue::of(1)), 2147483648.0, "INT32_MAX + 1");
+}
+
+TEST(applyWithZeroAndNegative) {
+    auto zero = NumericValue::of(0);
+    auto minusFive = NumericValue::of(-5);
+    expectDouble(NumericValue::apply("*", zero, minusFive), -0.0, "0 * -5");
+    expectDouble(NumericValue::apply("/", zero, minusFive), -0.0, "0 / -5");
+    expectDouble(NumericValue::apply("%", minusFive, NumericValue::of(5)), -0.0, "-5 % 5");
+    expectInteger(NumericValue::apply("*", zero, NumericValue::of(5)), 0, "0 * 5");
+    expectInteger(NumericValue::apply("%", NumericValue::of(5), minusFive), 0, "5 % -5");
+    expectInteger(NumericValue::apply("%", NumericValue::of(-7), NumericValue::of(5)), -2, "-7 % 5");
+}
+
+TEST(applyDivision) {
+    expectInteger(NumericValue::apply("/", NumericValue::of(-6), NumericValue::of(3)), -2, "-6 / 3");
+    expectDouble(NumericValue::apply("/", NumericValue::of(7), NumericValue::of(2)), 3.5, "7 / 2");
+    expectDouble(NumericValue::apply("/", NumericValue::of(1), NumericValue::of(0)),
+                 std::numeric_limits<double>::infinity(), "1 / 0");
+    expect(!NumericValue::apply("<", NumericValue::of(1), NumericValue::of(2)), "< daje broj");
+}
+
+TEST(compareMixesIntegersAndDoubles) {
+    expect(*NumericValue::compare("<", NumericValue::of(1), NumericValue::of(1.5)), "1 < 1.5 nije tačno");
+    expect(*NumericValue::compare("==", NumericValue::of(2), NumericValue::of(2.0)), "2 == 2.0 nije tačno");
+    expect(*NumericValue::compare("==", NumericValue::of(0), NumericValue::of(-0.0)), "0 == -0 nije tačno");
+    expect(!NumericValue::compare("+", NumericValue::of(1), NumericValue::of(2)), "+ daje logičku vrijednost");
+}
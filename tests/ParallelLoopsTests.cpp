@@ -0,0 +1,86 @@
+#include "Test.h"
+
+TEST(sumIsParallelReduction) {
+    auto output = compileAndPrint(R"(
+konst niz = [1, 2, 3];
+var s = 0;
+za svako (x od niz) {
+    s = s + x;
+}
+)");
+    expectContains(output, "/*parallel, reduce s*/");
+}
+
+TEST(targetOnTheRightIsNotReduction) {
+    auto output = compileAndPrint(R"(
+konst niz = ["a", "b", "c"];
+var s = "";
+za svako (x od niz) {
+    s = x + s;
+}
+)");
+    expectNotContains(output, "/*parallel");
+}
+
+TEST(mixedReductionFormsAreNotParallel) {
+    auto output = compileAndPrint(R"(
+konst niz = ["a", "b", "c"];
+var s = "";
+za svako (x od niz) {
+    s += x;
+    s = x + s;
+}
+)");
+    expectNotContains(output, "/*parallel");
+}
+
+TEST(stringSumIsNotParallel) {
+    // ("" + 1) + 2 is "12", "" + (1 + 2) is "3"
+    auto output = compileAndPrint(R"(
+konst niz = [1, 2, 3];
+var s = "";
+za svako (x od niz) {
+    s = s + x;
+}
+)");
+    expectNotContains(output, "/*parallel");
+}
+
+TEST(sumOverUnknownElementsIsNotParallel) {
+    auto output = compileAndPrint(R"(
+funkcija f(niz) {
+    var s = 0;
+    za svako (x od niz) {
+        s += x;
+    }
+    vrati s;
+}
+)");
+    expectNotContains(output, "/*parallel");
+}
+
+TEST(targetAssignedAStringIsNotParallel) {
+    auto output = compileAndPrint(R"(
+konst niz = [1.5, 2, 3];
+var s = 0;
+za svako (x od niz) {
+    s += x * 2;
+}
+s = "zbir: ";
+)");
+    expectNotContains(output, "/*parallel");
+}
+
+TEST(numericSumsAreParallel) {
+    auto output = compileAndPrint(R"(
+konst niz = [1.5, 2, 3];
+var s = 0;
+var n = 0;
+za svako (x od niz) {
+    s += x * 2;
+    ++n;
+}
+)");
+    expectContains(output, "/*parallel, reduce s, n*/");
+    expectContains(output, "(x/*double*/ od niz)");
+}
@@ -0,0 +1,72 @@
+#include "Test.h"
+#include <algorithm>
+#include <random>
+#include <unordered_map>
+#include "../compiler/PropertyDictionary.h"
+
+// Runs the same random inserts and erases on a PropertyDictionary and a std::unordered_map plus an insertion
+// order list, and checks that both agree on every lookup, the size and the iteration order
+static void compareWithReference(uint32_t keyRange, size_t operations, unsigned seed) {
+    PropertyDictionary dictionary;
+    std::unordered_map<uint32_t, uint32_t> reference;
+    std::vector<uint32_t> order;
+    std::mt19937 random(seed);
+
+    for (size_t i = 0; i < operations; i++) {
+        uint32_t key = random() % keyRange;
+        if (random() % 3 == 0) {
+            bool erased = reference.erase(key) == 1;
+            if (erased) {
+                order.erase(std::find(order.begin(), order.end(), key));
+            }
+            expect(dictionary.erase(key) == erased, "erase(" + std::to_string(key) + ") se ne slaže");
+        } else {
+            auto value = static_cast<uint32_t>(i);
+            bool inserted = reference.insert_or_assign(key, value).second;
+            if (inserted) {
+                order.push_back(key);
+            }
+            expect(dictionary.insert(key, value) == inserted, "insert(" + std::to_string(key) + ") se ne slaže");
+        }
+        expect(dictionary.size() == reference.size(), "Veličina se ne slaže nakon " + std::to_string(i) + " operacija");
+    }
+
+    for (uint32_t key = 0; key < keyRange; key++) {
+        auto expected = reference.find(key);
+        auto found = dictionary.find(key);
+        expect(found.has_value() == (expected != reference.end()), "find(" + std::to_string(key) + ") se ne slaže");
+        expect(!found || *found == expected->second, "Vrijednost za " + std::to_string(key) + " se ne slaže");
+    }
+
+    std::vector<uint32_t> visited;
+    dictionary.forEach([&](uint32_t key, uint32_t value) {
+        expect(reference.at(key) == value, "forEach vraća pogrešnu vrijednost za " + std::to_string(key));
+        visited.push_back(key);
+    });
+    expect(visited == order, "forEach ne poštuje redoslijed umetanja");
+}
+
+TEST(dictionaryMatchesUnorderedMapWithFewKeys) {
+    compareWithReference(8, 20000, 1);
+}
+
+TEST(dictionaryMatchesUnorderedMapWithManyKeys) {
+    compareWithReference(5000, 50000, 2);
+}
+
+TEST(dictionaryReusesErasedKey) {
+    PropertyDictionary dictionary;
+    dictionary.insert(7, 0);
+    for (uint32_t i = 1; i <= 100000; i++) {
+        expect(dictionary.insert(1, i), "Ključ 1 nije umetnut");
+        expect(dictionary.erase(1), "Ključ 1 nije obrisan");
+    }
+    dictionary.insert(1, 42);
+
+    std::vector<std::pair<uint32_t, uint32_t>> visited;
+    dictionary.forEach([&](uint32_t key, uint32_t value) {
+        visited.emplace_back(key, value);
+    });
+    expect(visited == std::vector<std::pair<uint32_t, uint32_t>>{{7, 0}, {1, 42}}, "forEach vraća pogrešne unose");
+    expect(dictionary.capacity() == PropertyDictionary::groupSize, "Tabela je narasla bez novih ključeva");
+}
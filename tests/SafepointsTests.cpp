@@ -0,0 +1,25 @@
+#include "Test.h"
+
+TEST(functionWithoutCallsChargesItsLoopsOnEntry) {
+    auto output = compileAndPrint(R"(
+funkcija zbir() {
+    var s = 0;
+    za svako (i od 1 do 100) {
+        s += i;
+    }
+    vrati s;
+}
+)");
+    expectContains(output, "funkcija zbir() /*safepoint 509*/");
+    expectContains(output, "za svako /*counted*/ /*int*/ (i od 1 do 100)");
+}
+
+TEST(longCountedLoopGetsBackEdgeCheck) {
+    auto output = compileAndPrint(R"(
+var s = 0;
+za svako (i od 1 do 1000000) {
+    s += i;
+}
+)");
+    expectContains(output, "za svako /*safepoint 5*/");
+}
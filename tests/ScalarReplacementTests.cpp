@@ -0,0 +1,66 @@
+#include "Test.h"
+
+static const char *model = R"(
+model P {
+    konstruktor(x, y){
+        @x = x;
+        @y = y;
+    }
+    javno {
+        var x, y;
+    }
+}
+)";
+
+TEST(localInstanceIsReplaced) {
+    auto output = compileAndPrint(std::string(model) + R"(
+funkcija f(c) {
+    var d = P(c, 2);
+    vrati d.x + d.y;
+}
+)");
+    expectContains(output, "var d#x = c, d#y = 2;");
+    expectContains(output, "vrati (d#x + d#y);");
+}
+
+TEST(useOutsideDeclaringBlockIsNotReplaced) {
+    // The last d.x reads the global d, not the instance declared inside ako
+    auto output = compileAndPrint(std::string(model) + R"(
+var d = {x: 7};
+funkcija f(c) {
+    ako (c) {
+        var d = P(1, 2);
+        ispis(d.x);
+    }
+    ispis(d.x);
+}
+)");
+    expectNotContains(output, "d#x");
+    expectContains(output, "var d = /*arena*/P(1, 2);");
+}
+
+TEST(shadowedNameIsNotReplaced) {
+    auto output = compileAndPrint(std::string(model) + R"(
+funkcija f(c) {
+    var d = {x: 1};
+    ako (c) {
+        var d = P(3, 4);
+        ispis(d.y);
+    }
+    vrati d.x;
+}
+)");
+    expectNotContains(output, "d#");
+}
+
+TEST(topLevelInstanceReadFromFunctionIsNotReplaced) {
+    auto output = compileAndPrint(std::string(model) + R"(
+var d = P(5, 6);
+funkcija f() {
+    vrati d.x;
+}
+ispis(d.y);
+)");
+    expectNotContains(output, "d#");
+    expectContains(output, "vrati d.x;");
+}
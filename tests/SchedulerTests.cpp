@@ -0,0 +1,90 @@
+#include "Test.h"
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "../compiler/Scheduler.h"
+#include "../compiler/WorkStealingDeque.h"
+
+TEST(dequeHandsOutEveryItemOnce) {
+    // The owner pushes and pops while thieves steal, starting small so the buffer grows under them
+    const int count = 100000;
+    std::vector<int> items(count);
+    std::vector<std::atomic<int>> taken(count);
+    WorkStealingDeque<int *> deque(2);
+    std::atomic<int> remaining{count};
+
+    auto take = [&](int *item) {
+        taken[item - items.data()].fetch_add(1);
+        remaining.fetch_sub(1);
+    };
+    std::vector<std::thread> thieves;
+    for (int i = 0; i < 3; i++) {
+        thieves.emplace_back([&]() {
+            while (remaining.load() > 0) {
+                if (auto item = deque.steal()) take(item);
+            }
+        });
+    }
+    for (int i = 0; i < count; i++) {
+        deque.push(&items[i]);
+        if (i % 3 == 0) {
+            if (auto item = deque.pop()) take(item);
+        }
+    }
+    while (remaining.load() > 0) {
+        if (auto item = deque.pop()) take(item);
+    }
+    for (auto &thief: thieves) {
+        thief.join();
+    }
+
+    for (int i = 0; i < count; i++) {
+        expect(taken[i].load() == 1, "Element " + std::to_string(i) + " je uzet " + std::to_string(taken[i].load()) + " puta");
+    }
+    expect(!deque.pop() && !deque.steal(), "Red nije prazan");
+}
+
+TEST(schedulerRunsExternalAndNestedSubmits) {
+    // Every outside task submits children from a worker, which other workers have to steal
+    std::atomic<int> ran{0};
+    Scheduler scheduler(4);
+    for (int round = 0; round < 3; round++) {
+        for (int i = 0; i < 200; i++) {
+            scheduler.submit([&scheduler, &ran]() {
+                for (int j = 0; j < 20; j++) {
+                    scheduler.submit([&ran]() {
+                        ran.fetch_add(1);
+                    });
+                }
+                ran.fetch_add(1);
+            });
+        }
+        scheduler.wait();
+        expect(ran.load() == (round + 1) * 200 * 21, "Izvršeno je " + std::to_string(ran.load()) + " zadataka");
+    }
+}
+
+TEST(schedulerRethrowsTaskError) {
+    std::atomic<int> ran{0};
+    Scheduler scheduler(3);
+    for (int i = 0; i < 100; i++) {
+        scheduler.submit([i, &ran]() {
+            ran.fetch_add(1);
+            if (i == 42) throw std::runtime_error("greska");
+        });
+    }
+    bool rethrown = false;
+    try {
+        scheduler.wait();
+    } catch (const std::runtime_error &e) {
+        rethrown = std::string(e.what()) == "greska";
+    }
+    expect(rethrown, "Greška zadatka nije proslijeđena");
+    expect(ran.load() == 100, "Greška je zaustavila ostale zadatke");
+
+    // The error is reported once, the scheduler keeps running tasks
+    scheduler.submit([&ran]() { ran.fetch_add(1); });
+    scheduler.wait();
+    expect(ran.load() == 101, "Zadatak poslije greške nije izvršen");
+}
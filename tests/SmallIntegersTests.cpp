@@ -0,0 +1,60 @@
+#include "Test.h"
+
+TEST(integerBoundsMarkCounterAndIndex) {
+    auto output = compileAndPrint(R"(
+funkcija f(niz) {
+    za svako (i od 0 do 10) {
+        ispis(niz[i]);
+    }
+    za svako (j od 10 do 0 korak -2) {
+        ispis(niz[j]);
+    }
+}
+)");
+    expectContains(output, "/*int*/ (i od 0 do 10)");
+    expectContains(output, "niz[i]/*int*/");
+    expectContains(output, "/*int*/ (j od 10 do 0 korak -2)");
+    expectContains(output, "niz[j]/*int*/");
+}
+
+TEST(counterPastInt32IsNotInteger) {
+    // The counter ends at 2147483647 + 1, which is not a small integer
+    auto output = compileAndPrint(R"(
+funkcija f(niz) {
+    za svako (i od 0 do 2147483647) {
+        ispis(niz[i]);
+    }
+}
+)");
+    expectNotContains(output, "/*int*/");
+}
+
+TEST(stepAwayFromEndIsNotInteger) {
+    auto output = compileAndPrint(R"(
+funkcija f(niz) {
+    za svako (i od 10 do 0 korak 1) {
+        ispis(niz[i]);
+    }
+    za svako (j od 0 do 10 korak 0.5) {
+        ispis(niz[j]);
+    }
+}
+)");
+    expectNotContains(output, "/*int*/");
+}
+
+TEST(counterReadByNestedFunctionIsNotInteger) {
+    // The function can run after the loop has moved on
+    auto output = compileAndPrint(R"(
+funkcija f(niz) {
+    za svako (i od 0 do 10) {
+        var g = funkcija(k) {
+            vrati niz[i] + k;
+        };
+        niz[i] = g;
+    }
+}
+)");
+    expectContains(output, "niz[i]/*int*/ = ");
+    expectContains(output, "vrati (niz[i] + k);");
+}
@@ -0,0 +1,45 @@
+#include "Test.h"
+
+TEST(selfRecursiveFunctionIsSelfTailCall) {
+    auto output = compileAndPrint(R"(
+funkcija broji(n) {
+    ako (n == 0) {
+        vrati 0;
+    }
+    vrati broji(n - 1);
+}
+)");
+    expectContains(output, "vrati /*self tail*/ broji((n - 1))");
+}
+
+TEST(modelMethodNameIsNotSelfTailCall) {
+    auto output = compileAndPrint(R"(
+model Brojac {
+    konstruktor() {}
+    javno {
+        funkcija broji(n) {
+            ako (n == 0) {
+                vrati 0;
+            }
+            vrati broji(n - 1);
+        }
+    }
+}
+)");
+    expectContains(output, "vrati /*tail*/ broji(");
+    expectNotContains(output, "/*self tail*/");
+}
+
+TEST(callInsideTryIsNotTailCall) {
+    auto output = compileAndPrint(R"(
+funkcija f(n) {
+    probaj {
+        vrati g(n);
+    } spasi {
+        vrati 0;
+    }
+}
+)");
+    expectContains(output, "vrati g(n)");
+    expectNotContains(output, "/*tail*/ g(");
+}
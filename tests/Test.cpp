@@ -0,0 +1,58 @@
+#include "Test.h"
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+#include "../compiler/Compiler.h"
+#include "../parser/Parser.h"
+#include "../parser/AST/ASTPrinter.h"
+
+std::vector<TestCase> &TestCase::all() {
+    static std::vector<TestCase> cases;
+    return cases;
+}
+
+void expect(bool condition, const std::string &message) {
+    if (!condition) {
+        throw std::runtime_error(message);
+    }
+}
+
+std::string compileAndPrint(const std::string &source) {
+    Parser parser(false);
+    auto program = parser.parseProgram(source);
+    Compiler compiler;
+    compiler.compile(program);
+    return ASTPrinter::print(&program);
+}
+
+std::string compileError(const std::string &source) {
+    try {
+        compileAndPrint(source);
+    } catch (const std::runtime_error &e) {
+        return e.what();
+    }
+    return "";
+}
+
+void expectContains(const std::string &output, const std::string &text) {
+    expect(output.find(text) != std::string::npos, "Nije pronađeno \"" + text + "\" u:\n" + output);
+}
+
+void expectNotContains(const std::string &output, const std::string &text) {
+    expect(output.find(text) == std::string::npos, "Pronađeno je \"" + text + "\" u:\n" + output);
+}
+
+int main() {
+    size_t failed = 0;
+    for (const auto &test: TestCase::all()) {
+        try {
+            test.body();
+            std::cout << "[ OK ] " << test.name << std::endl;
+        } catch (const std::exception &e) {
+            failed++;
+            std::cout << "[FAIL] " << test.name << ": " << e.what() << std::endl;
+        }
+    }
+    std::cout << TestCase::all().size() - failed << " of " << TestCase::all().size() << " tests passed" << std::endl;
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,39 @@
+#ifndef BOSSCRIPT_TEST_H
+#define BOSSCRIPT_TEST_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+// Every TEST registers itself with the runner in Test.cpp. A test fails by throwing
+class TestCase {
+public:
+    const char *name;
+    void (*body)();
+
+    static std::vector<TestCase> &all();
+
+    TestCase(const char *name, void (*body)()) : name(name), body(body) {
+        all().push_back(*this);
+    }
+};
+
+#define TEST(name) \
+    static void name(); \
+    static TestCase name##Case(#name, name); \
+    static void name()
+
+void expect(bool condition, const std::string &message);
+
+// Parses and compiles source with every compiler pass, then prints it with the pass annotations
+std::string compileAndPrint(const std::string &source);
+
+// Compiles source like compileAndPrint and returns the error message, or an empty string if it compiled
+std::string compileError(const std::string &source);
+
+void expectContains(const std::string &output, const std::string &text);
+
+void expectNotContains(const std::string &output, const std::string &text);
+
+
+#endif //BOSSCRIPT_TEST_H